@@ -0,0 +1,18 @@
+#version 330 core
+
+in vec2 frag_uv;
+in vec3 frag_normal;
+in float frag_opacity;
+
+out vec4 color;
+
+// the Object's texture, or white when it has none
+uniform sampler2D diffuse_texture;
+
+const vec3 LIGHT_DIRECTION = normalize(vec3(0.4, 1.0, 0.6));
+
+void main()
+{
+  float diffuse = max(dot(normalize(frag_normal), LIGHT_DIRECTION), 0.0);
+  color = texture(diffuse_texture, frag_uv) * vec4(vec3(0.2 + 0.8 * diffuse), frag_opacity);
+}
@@ -0,0 +1,33 @@
+#version 330 core
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 uv;
+layout(location = 2) in vec3 normal;
+// per instance, locations 3 to 7
+layout(location = 3) in mat4 model;
+layout(location = 7) in float opacity;
+
+// shared by every shader, see FrameUniforms.h
+layout(std140) uniform Frame
+{
+  mat4 view;
+  mat4 projection;
+  mat4 view_projection;
+  vec3 cam_up;
+  vec3 cam_right;
+  vec2 viewport_size;
+  float time;
+};
+
+out vec2 frag_uv;
+out vec3 frag_normal;
+out float frag_opacity;
+
+void main()
+{
+  frag_uv = uv;
+  frag_opacity = opacity;
+  // fine for uniform scale, non-uniform scale skews the normal slightly
+  frag_normal = mat3(model) * normal;
+  gl_Position = view_projection * model * vec4(position, 1.0);
+}
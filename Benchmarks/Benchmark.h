@@ -0,0 +1,70 @@
+/*! \file Benchmark.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains the minimal registration and timing helpers used by the benchmark target.
+*/
+
+#pragma once
+
+#include <chrono>
+
+namespace Benchmark
+{
+  //! Signature of a benchmark, given argc/argv after the benchmark name.
+  typedef void (*Function)(int argc, char* argv[]);
+
+  //! Registers a benchmark with the runner on construction.
+  struct Registrar
+  {
+    /*! \brief Adds a benchmark to the list run by main.
+        \param name The name used to select the benchmark from the command line.
+        \param function The benchmark to run.
+    */
+    Registrar(const char* name, Function function);
+  };
+
+  //! Measures elapsed time on the steady clock.
+  struct Timer
+  {
+    //! \brief Starts the timer.
+    Timer() : start(std::chrono::steady_clock::now()) {}
+    
+    //! \return Milliseconds elapsed since construction or the last Restart.
+    double Ms() const
+    {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    //! \brief Restarts the timer.
+    void Restart() { start = std::chrono::steady_clock::now(); }
+
+    std::chrono::steady_clock::time_point start;
+  };
+
+  /*! \brief Prints a single result line.
+      \param label What was measured.
+      \param ms The time taken in milliseconds.
+      \param count The number of items processed, used to print the per item cost.
+  */
+  void Report(const char* label, double ms, double count);
+
+  /*! \brief Prints a single result line with throughput.
+      \param label What was measured.
+      \param ms The time taken in milliseconds.
+      \param bytes The number of bytes processed, printed as MB/s.
+      \param count The number of items processed, printed as items/s.
+      \param item_name What an item is, such as "verts".
+  */
+  void ReportThroughput(const char* label, double ms, double bytes, double count, const char* item_name);
+
+  /*! \brief Keeps a value alive so the optimizer cannot remove the work producing it.
+      \param value The value to consume.
+  */
+  void DoNotOptimize(double value);
+}
+
+//! Defines and registers a benchmark function named NAME.
+#define BENCHMARK(NAME)                                                                           \
+  static void NAME##_Benchmark_(int argc, char* argv[]);                                          \
+  static Benchmark::Registrar NAME##_registrar_(#NAME, NAME##_Benchmark_);                        \
+  static void NAME##_Benchmark_(int argc, char* argv[])
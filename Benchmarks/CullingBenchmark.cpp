@@ -0,0 +1,138 @@
+/*! \file CullingBenchmark.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Compares the SIMD frustum culling kernel against the scalar one and the Bvh.
+
+    Usage: Culling [count], count defaults to 1000000 bounds scattered around the camera.
+*/
+
+#include "Benchmark.h"
+#include "../Source/Math/Culling.h"
+#include "../Source/Math/Bvh.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+  const int RUNS = 10;
+}
+
+BENCHMARK(Culling)
+{
+  unsigned count = argc > 0 ? unsigned(atoi(argv[0])) : 1000000;
+  
+  // the default camera, looking down -z with a 90 degree field of view
+  glm::mat4 projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+  glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+  Frustum frustum;
+  frustum.FromMatrix(glm::value_ptr(projection * view));
+  
+  std::mt19937 random(1234);
+  std::uniform_real_distribution<float> position(-120.0f, 120.0f), size(0.1f, 2.0f);
+  BoundsSoA bounds;
+  bounds.Reserve(count);
+  std::vector<Aabb> boxes(count);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    float center[3] = {position(random), position(random), position(random)};
+    float extents[3] = {size(random), size(random), size(random)};
+    float radius = sqrtf(extents[0] * extents[0] + extents[1] * extents[1] + extents[2] * extents[2]);
+    bounds.Add(center, radius, extents);
+    boxes[i] = Aabb{{center[0] - extents[0], center[1] - extents[1], center[2] - extents[2]},
+                    {center[0] + extents[0], center[1] + extents[1], center[2] + extents[2]}};
+  }
+  
+  std::vector<unsigned> simd(count), scalar(count);
+  unsigned simd_count = 0, scalar_count = 0;
+  Benchmark::Timer timer;
+  for (int i = 0; i < RUNS; ++i)
+    scalar_count = CullFrustumScalar(frustum, bounds, scalar.data());
+  double scalar_ms = timer.Ms() / RUNS;
+  
+  timer.Restart();
+  for (int i = 0; i < RUNS; ++i)
+    simd_count = CullFrustum(frustum, bounds, simd.data());
+  double simd_ms = timer.Ms() / RUNS;
+  
+  if (simd_count != scalar_count || !std::equal(simd.begin(), simd.begin() + simd_count, scalar.begin()))
+  {
+    printf("  ERROR: CullFrustum differs from CullFrustumScalar\n");
+    return;
+  }
+  
+  printf("  %u bounds, %u visible\n", count, simd_count);
+  Benchmark::Report("CullFrustumScalar", scalar_ms, double(count));
+  Benchmark::Report(CullFrustumUsesAvx() ? "CullFrustum, AVX" : "CullFrustum, SSE", simd_ms, double(count));
+  
+  // the tree only tests boxes, so it may keep a few the sphere test drops
+  std::vector<unsigned> keys(count);
+  for (unsigned i = 0; i < count; ++i)
+    keys[i] = i;
+  Bvh bvh;
+  timer.Restart();
+  bvh.Build(keys.data(), boxes.data(), count);
+  Benchmark::Report("Bvh::Build", timer.Ms(), double(count));
+  
+  unsigned bvh_count = 0;
+  timer.Restart();
+  for (int i = 0; i < RUNS; ++i)
+    bvh_count = bvh.CullFrustum(frustum, simd.data());
+  Benchmark::Report("Bvh::CullFrustum", timer.Ms() / RUNS, double(count));
+  printf("  %u visible to the tree\n", bvh_count);
+  
+  // move a tenth of the boxes a little, like a frame of animated objects
+  std::uniform_real_distribution<float> nudge(-0.5f, 0.5f);
+  timer.Restart();
+  for (unsigned i = 0; i < count; i += 10)
+  {
+    float offset = nudge(random);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      boxes[i].min[axis] += offset;
+      boxes[i].max[axis] += offset;
+    }
+    bvh.Update(i, boxes[i]);
+  }
+  bvh.Refit();
+  Benchmark::Report("Bvh::Update and Refit, 10% moved", timer.Ms(), double(count / 10));
+  printf("  needs rebuild: %s\n", bvh.NeedsRebuild() ? "yes" : "no");
+  
+  // delete and create a hundredth of the objects, each only touches one leaf and the boxes above it
+  timer.Restart();
+  for (unsigned i = 0; i < count; i += 100)
+    bvh.Remove(i);
+  for (unsigned i = 0; i < count; i += 100)
+    bvh.Insert(i, boxes[i]);
+  Benchmark::Report("Bvh::Remove and Insert, 1% churned", timer.Ms(), double(count / 100));
+  
+  Bvh rebuilt;
+  rebuilt.Build(keys.data(), boxes.data(), count);
+  if (bvh.CullFrustum(frustum, simd.data()) != rebuilt.CullFrustum(frustum, scalar.data()))
+  {
+    printf("  ERROR: the refit tree differs from a rebuilt one\n");
+    return;
+  }
+  
+  const unsigned RAYS = 10000;
+  float origin[3] = {0.0f, 0.0f, 0.0f};
+  unsigned hits = 0;
+  timer.Restart();
+  for (unsigned i = 0; i < RAYS; ++i)
+  {
+    float direction[3] = {nudge(random), nudge(random), -1.0f};
+    unsigned item;
+    float distance;
+    hits += bvh.Raycast(origin, direction, item, distance);
+  }
+  Benchmark::Report("Bvh::Raycast", timer.Ms(), double(RAYS));
+  printf("  %u of %u rays hit\n", hits, RAYS);
+}
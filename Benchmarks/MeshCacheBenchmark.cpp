@@ -0,0 +1,91 @@
+/*! \file MeshCacheBenchmark.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Compares a cold model import, which parses and writes the cache, against a warm one that maps it.
+
+    Usage: MeshCache [file.obj | grid_size]. Without a file a grid_size x grid_size
+    quad grid (default 512) is written next to the executable. The cache is
+    written to MeshCacheBenchmark/ beside it.
+*/
+
+#include "Benchmark.h"
+#include "TestModels.h"
+#include "../Source/Graphics/Model/MeshCache.h"
+#include "../Source/Threading/ThreadPool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+  const int RUNS = 5;
+  const char* CACHE_FOLDER = "MeshCacheBenchmark/";
+
+  // stands in for glBufferData, which reads every byte of the view once
+  double Consume(const MeshView& view, std::vector<char>& buffer)
+  {
+    size_t vertex_bytes = size_t(view.vertex_count) * MeshData::VERTEX_FLOATS * sizeof(float);
+    size_t index_bytes = size_t(view.index_count) * sizeof(unsigned);
+    buffer.resize(vertex_bytes + index_bytes);
+    memcpy(buffer.data(), view.vertices, vertex_bytes);
+    memcpy(buffer.data() + vertex_bytes, view.indices, index_bytes);
+    return double(buffer[buffer.size() / 2]);
+  }
+
+  void Run(const char* label, const char* path, ThreadPool* pool, bool cold, std::vector<char>& buffer)
+  {
+    double total = 0.0;
+    ImportedMesh mesh;
+    for (int i = 0; i < RUNS; ++i)
+    {
+      std::error_code error;
+      if (cold)
+        std::filesystem::remove_all(CACHE_FOLDER, error);
+      
+      mesh = ImportedMesh();
+      Benchmark::Timer timer;
+      if (!ImportMesh(path, mesh, pool, CACHE_FOLDER))
+      {
+        printf("  could not import %s\n", path);
+        return;
+      }
+      Benchmark::DoNotOptimize(Consume(mesh.View(), buffer));
+      total += timer.Ms();
+      
+      if (mesh.from_cache == cold)
+        printf("  ERROR: expected the cache to be %s\n", cold ? "missed" : "hit");
+    }
+    Benchmark::Report(label, total / RUNS, mesh.View().vertex_count);
+  }
+}
+
+BENCHMARK(MeshCache)
+{
+  std::string path = "MeshCacheBenchmark.obj";
+  if (argc > 0 && strstr(argv[0], ".obj"))
+    path = argv[0];
+  else
+  {
+    unsigned size = argc > 0 ? unsigned(atoi(argv[0])) : 512;
+    if (!WriteGrid(path.c_str(), size))
+    {
+      printf("  could not write %s\n", path.c_str());
+      return;
+    }
+  }
+  
+  std::error_code error;
+  printf("  %s, %.1f MB\n", path.c_str(), double(std::filesystem::file_size(path, error)) / (1024.0 * 1024.0));
+  
+  std::vector<char> buffer;
+  ThreadPool pool;
+  Run("cold, parse 1 thread + write", path.c_str(), nullptr, true, buffer);
+  Run("cold, parse pool + write", path.c_str(), &pool, true, buffer);
+  Run("warm, hash + map", path.c_str(), nullptr, false, buffer);
+  
+  std::filesystem::remove_all(CACHE_FOLDER, error);
+}
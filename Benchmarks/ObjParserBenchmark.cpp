@@ -0,0 +1,104 @@
+/*! \file ObjParserBenchmark.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Measures OBJ import throughput in MB/s and vertices/s.
+
+    Usage: ObjParser [file.obj | grid_size]. Without a file a grid_size x grid_size
+    quad grid (default 1024) is written next to the executable and parsed.
+*/
+
+#include "Benchmark.h"
+#include "TestModels.h"
+#include "../Source/Graphics/Model/ObjParser.h"
+#include "../Source/Memory/MappedFile.h"
+#include "../Source/Threading/ThreadPool.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+  const int RUNS = 3;
+
+  // the getline and istringstream approach the importer started with, counting only
+  size_t ParseWithStreams(const char* path)
+  {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    std::string line, type;
+    size_t values = 0;
+    while (std::getline(file, line))
+    {
+      std::istringstream stream(line);
+      stream >> type;
+      if (type == "v" || type == "vn" || type == "vt")
+      {
+        float value;
+        while (stream >> value)
+          ++values;
+      }
+      else if (type == "f")
+      {
+        std::string token;
+        while (stream >> token)
+          values += strtol(token.c_str(), nullptr, 10) != 0;
+      }
+    }
+    return values;
+  }
+}
+
+BENCHMARK(ObjParser)
+{
+  std::string path = "ObjParserBenchmark.obj";
+  if (argc > 0 && strstr(argv[0], ".obj"))
+    path = argv[0];
+  else
+  {
+    unsigned size = argc > 0 ? unsigned(atoi(argv[0])) : 1024;
+    Benchmark::Timer timer;
+    WriteGrid(path.c_str(), size);
+    printf("  wrote %ux%u grid to %s in %.0f ms\n", size, size, path.c_str(), timer.Ms());
+  }
+
+  MappedFile file;
+  if (!file.Open(path.c_str()))
+  {
+    printf("  could not open %s\n", path.c_str());
+    return;
+  }
+  double bytes = double(file.Size());
+  printf("  %s, %.1f MB\n", path.c_str(), bytes / (1024.0 * 1024.0));
+
+  // touch every page once so all runs read from the page cache
+  size_t checksum = 0;
+  for (size_t i = 0; i < file.Size(); i += 4096)
+    checksum += file.Data()[i];
+  Benchmark::DoNotOptimize(double(checksum));
+
+  MeshData mesh;
+  Benchmark::Timer timer;
+  ParseObj(path.c_str(), mesh);
+  double vertices = mesh.VertexCount();
+  printf("  %u vertices, %zu triangles\n", mesh.VertexCount(), mesh.indices.size() / 3);
+
+  timer.Restart();
+  Benchmark::DoNotOptimize(double(ParseWithStreams(path.c_str())));
+  Benchmark::ReportThroughput("iostream tokenizing only", timer.Ms(), bytes, vertices, "verts");
+
+  timer.Restart();
+  for (int i = 0; i < RUNS; ++i)
+    ParseObj(path.c_str(), mesh);
+  Benchmark::ReportThroughput("ParseObj, 1 thread", timer.Ms() / RUNS, bytes, vertices, "verts");
+
+  ThreadPool pool;
+  timer.Restart();
+  for (int i = 0; i < RUNS; ++i)
+    ParseObj(path.c_str(), mesh, &pool);
+  char label[64];
+  snprintf(label, sizeof(label), "ParseObj, %u threads", pool.ThreadCount() + 1);
+  Benchmark::ReportThroughput(label, timer.Ms() / RUNS, bytes, vertices, "verts");
+}
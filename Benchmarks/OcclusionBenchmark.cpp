@@ -0,0 +1,100 @@
+/*! \file OcclusionBenchmark.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Measures OcclusionBuffer rasterization and box tests behind a wall of occluders.
+
+    Usage: Occlusion [box_count], box_count defaults to 100000 boxes, half in front of the wall.
+*/
+
+#include "Benchmark.h"
+#include "../Source/Math/OcclusionBuffer.h"
+#include "../Source/Threading/ThreadPool.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+  const int RUNS = 20;
+  //! Quads per side of the wall, so it has GRID * GRID * 2 triangles.
+  const unsigned GRID = 64;
+  //! The wall is a square of this half size at this depth in front of the camera.
+  const float WALL_SIZE = 20.0f;
+  const float WALL_DEPTH = -10.0f;
+}
+
+BENCHMARK(Occlusion)
+{
+  unsigned count = argc > 0 ? unsigned(atoi(argv[0])) : 100000;
+  
+  glm::mat4 projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+  glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+  glm::mat4 view_projection = projection * view;
+  glm::mat4 model(1.0f);
+  
+  // a finely tessellated wall, like an interior wall mesh
+  std::vector<float> positions;
+  std::vector<unsigned> indices;
+  for (unsigned y = 0; y <= GRID; ++y)
+    for (unsigned x = 0; x <= GRID; ++x)
+    {
+      positions.push_back(-WALL_SIZE + 2.0f * WALL_SIZE * x / GRID);
+      positions.push_back(-WALL_SIZE + 2.0f * WALL_SIZE * y / GRID);
+      positions.push_back(WALL_DEPTH);
+    }
+  for (unsigned y = 0; y < GRID; ++y)
+    for (unsigned x = 0; x < GRID; ++x)
+    {
+      unsigned corner = y * (GRID + 1) + x;
+      unsigned quad[6] = {corner, corner + 1, corner + GRID + 2, corner, corner + GRID + 2, corner + GRID + 1};
+      indices.insert(indices.end(), quad, quad + 6);
+    }
+  
+  // boxes in view, half in front of the wall and half behind it
+  std::mt19937 random(1234);
+  std::uniform_real_distribution<float> spread(-0.8f, 0.8f), size(0.1f, 0.5f);
+  std::uniform_real_distribution<float> front(-9.0f, -1.0f), behind(-60.0f, -11.0f);
+  std::vector<Aabb> boxes(count);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    float z = i % 2 ? behind(random) : front(random);
+    float center[3] = {spread(random) * -z, spread(random) * -z * 0.5f, z};
+    float extent = size(random);
+    boxes[i] = Aabb{{center[0] - extent, center[1] - extent, center[2] - extent}, {center[0] + extent, center[1] + extent, center[2] + extent}};
+  }
+  
+  OcclusionBuffer buffer;
+  ThreadPool pool;
+  for (int threaded = 0; threaded < 2; ++threaded)
+  {
+    Benchmark::Timer timer;
+    for (int i = 0; i < RUNS; ++i)
+    {
+      buffer.Begin(glm::value_ptr(view_projection));
+      buffer.AddOccluder(glm::value_ptr(model), positions.data(), indices.data(), unsigned(indices.size()));
+      buffer.Rasterize(threaded ? &pool : nullptr);
+    }
+    char label[64];
+    snprintf(label, sizeof(label), "setup and rasterize, %u threads", threaded ? pool.ThreadCount() + 1 : 1);
+    Benchmark::Report(label, timer.Ms() / RUNS, double(buffer.LastStats().triangles));
+  }
+  
+  unsigned culled = 0, culled_in_front = 0;
+  Benchmark::Timer timer;
+  for (unsigned i = 0; i < count; ++i)
+    if (!buffer.IsVisible(boxes[i]))
+    {
+      ++culled;
+      culled_in_front += i % 2 == 0;
+    }
+  Benchmark::Report("IsVisible", timer.Ms(), double(count));
+  printf("  %u triangles, %u of %u boxes culled\n", buffer.LastStats().triangles, culled, count);
+  if (culled_in_front)
+    printf("  ERROR: %u boxes in front of the wall were culled\n", culled_in_front);
+}
@@ -0,0 +1,73 @@
+/*! \file RadixSortBenchmark.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Compares RadixSortByKey against std::sort on render queue style keys.
+
+    Usage: RadixSort [count], count defaults to 100000.
+*/
+
+#include "Benchmark.h"
+#include "../Source/Math/RadixSort.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+  struct Entry
+  {
+    unsigned long long key;
+    unsigned item;
+  };
+
+  const int RUNS = 10;
+
+  void Run(const char* label, const std::vector<Entry>& source)
+  {
+    std::vector<Entry> data, scratch(source.size());
+    
+    double radix_ms = 0.0, std_ms = 0.0;
+    for (int i = 0; i < RUNS; ++i)
+    {
+      data = source;
+      Benchmark::Timer timer;
+      RadixSortByKey(data.data(), scratch.data(), data.size());
+      radix_ms += timer.Ms();
+      
+      std::vector<Entry> check = source;
+      timer.Restart();
+      std::stable_sort(check.begin(), check.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+      std_ms += timer.Ms();
+      
+      for (size_t j = 0; j < data.size(); ++j)
+        if (data[j].key != check[j].key || data[j].item != check[j].item)
+        {
+          printf("  ERROR: radix sort differs from std::stable_sort at %zu\n", j);
+          return;
+        }
+    }
+    
+    printf("  %s\n", label);
+    Benchmark::Report("    RadixSortByKey", radix_ms / RUNS, double(source.size()));
+    Benchmark::Report("    std::stable_sort", std_ms / RUNS, double(source.size()));
+  }
+}
+
+BENCHMARK(RadixSort)
+{
+  unsigned count = argc > 0 ? unsigned(atoi(argv[0])) : 100000;
+  std::mt19937_64 random(1234);
+  std::vector<Entry> entries(count);
+  
+  for (unsigned i = 0; i < count; ++i)
+    entries[i] = Entry{random(), i};
+  Run("random 64-bit keys", entries);
+  
+  // a few states and a depth in the low bits, like a frame of opaque props
+  for (unsigned i = 0; i < count; ++i)
+    entries[i] = Entry{(unsigned long long)(random() % 8) << 24 | (random() & 0xFFFFFF), i};
+  Run("8 states with 24-bit depth", entries);
+}
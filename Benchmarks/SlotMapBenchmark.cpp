@@ -0,0 +1,113 @@
+/*! \file SlotMapBenchmark.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Compares SlotMap against the unordered_map of heap allocated objects it replaced in Graphics.
+
+    Usage: SlotMap [count], count defaults to 1000000.
+*/
+
+#include "Benchmark.h"
+#include "../Source/Memory/SlotMap.h"
+#include "../Source/Math/Vector.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  // the per object data touched by Graphics::Draw_, without the ImGui registration
+  struct ObjectData
+  {
+    ObjectData(unsigned id_) : id(id_), scale(1, 1, 1) {}
+
+    unsigned id;
+    Vector position;
+    Vector rotation;
+    Vector scale;
+  };
+
+  const int ITERATIONS = 10;
+
+  double Touch(const ObjectData& obj)
+  {
+    return obj.position.x + obj.rotation.y + obj.scale.z;
+  }
+
+  void RunMap(const std::vector<unsigned>& order)
+  {
+    unsigned count = unsigned(order.size());
+    std::unordered_map<unsigned, ObjectData*> objects;
+    Benchmark::Timer timer;
+
+    for (unsigned i = 0; i < count; ++i)
+      objects.emplace(i, new ObjectData(i));
+    Benchmark::Report("unordered_map create", timer.Ms(), count);
+
+    timer.Restart();
+    double sum = 0.0;
+    for (int i = 0; i < ITERATIONS; ++i)
+      for (auto it = objects.begin(); it != objects.end(); ++it)
+        sum += Touch(*it->second);
+    Benchmark::Report("unordered_map iterate", timer.Ms() / ITERATIONS, count);
+    Benchmark::DoNotOptimize(sum);
+
+    timer.Restart();
+    for (unsigned i = 0; i < count; ++i)
+    {
+      auto it = objects.find(order[i]);
+      delete it->second;
+      objects.erase(it);
+    }
+    Benchmark::Report("unordered_map delete", timer.Ms(), count);
+  }
+
+  void RunSlotMap(const std::vector<unsigned>& order)
+  {
+    unsigned count = unsigned(order.size());
+    SlotMap<ObjectData> objects;
+    std::vector<unsigned> handles(count);
+    Benchmark::Timer timer;
+
+    for (unsigned i = 0; i < count; ++i)
+      handles[i] = objects.Emplace(objects.NextHandle());
+    Benchmark::Report("SlotMap create", timer.Ms(), count);
+
+    timer.Restart();
+    double sum = 0.0;
+    for (int i = 0; i < ITERATIONS; ++i)
+      for (auto it = objects.begin(); it != objects.end(); ++it)
+        sum += Touch(*it);
+    Benchmark::Report("SlotMap iterate", timer.Ms() / ITERATIONS, count);
+    Benchmark::DoNotOptimize(sum);
+
+    timer.Restart();
+    for (unsigned i = 0; i < count; ++i)
+      objects.Remove(handles[order[i]]);
+    Benchmark::Report("SlotMap delete", timer.Ms(), count);
+
+    // every handle is stale now, which the old map could not detect
+    unsigned stale = 0;
+    for (unsigned i = 0; i < count; ++i)
+      stale += objects.Get(handles[i]) == nullptr;
+    if (stale != count)
+      printf("  ERROR: %u handles were not detected as stale\n", count - stale);
+  }
+}
+
+BENCHMARK(SlotMap)
+{
+  unsigned count = argc > 0 ? unsigned(atoi(argv[0])) : 1000000;
+
+  // delete in random order so neither container gets a friendly access pattern
+  std::vector<unsigned> order(count);
+  for (unsigned i = 0; i < count; ++i)
+    order[i] = i;
+  std::shuffle(order.begin(), order.end(), std::mt19937(1234));
+
+  RunMap(order);
+  RunSlotMap(order);
+}
@@ -0,0 +1,33 @@
+/*! \file TestModels.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of the benchmark model generators.
+*/
+
+#include "TestModels.h"
+
+#include <cstdio>
+
+bool WriteGrid(const char* path, unsigned size)
+{
+  FILE* file = fopen(path, "wb");
+  if (!file)
+    return false;
+  for (unsigned y = 0; y <= size; ++y)
+    for (unsigned x = 0; x <= size; ++x)
+      fprintf(file, "v %.6f %.6f %.6f\n", x / float(size), y / float(size), 0.01f * float((x * 7 + y * 13) % 17));
+  for (unsigned y = 0; y <= size; ++y)
+    for (unsigned x = 0; x <= size; ++x)
+      fprintf(file, "vt %.6f %.6f\n", x / float(size), y / float(size));
+  fprintf(file, "vn 0 0 1\n");
+  for (unsigned y = 0; y < size; ++y)
+    for (unsigned x = 0; x < size; ++x)
+    {
+      unsigned a = y * (size + 1) + x + 1;
+      unsigned b = a + 1;
+      unsigned c = b + size + 1;
+      unsigned d = a + size + 1;
+      fprintf(file, "f %u/%u/1 %u/%u/1 %u/%u/1 %u/%u/1\n", a, a, b, b, c, c, d, d);
+    }
+  return fclose(file) == 0;
+}
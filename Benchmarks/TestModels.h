@@ -0,0 +1,14 @@
+/*! \file TestModels.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains generators for the models used by the import benchmarks.
+*/
+
+#pragma once
+
+/*! \brief Writes a size x size quad grid with positions, uvs, and a shared normal as an OBJ file.
+    \param path The file to write.
+    \param size The number of quads along each side.
+    \return False if the file could not be written.
+*/
+bool WriteGrid(const char* path, unsigned size);
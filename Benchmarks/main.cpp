@@ -0,0 +1,81 @@
+/*! \file main.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Runs the registered benchmarks, all of them or the one named on the command line.
+
+    Usage: 3D_GraphicsTest_Benchmarks [name [args...]]
+*/
+
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  struct Entry
+  {
+    const char* name;
+    Benchmark::Function function;
+  };
+
+  // function local so registration order across files does not matter
+  std::vector<Entry>& Entries()
+  {
+    static std::vector<Entry> entries;
+    return entries;
+  }
+
+  volatile double sink;
+}
+
+namespace Benchmark
+{
+  Registrar::Registrar(const char* name, Function function)
+  {
+    Entries().push_back(Entry{name, function});
+  }
+
+  void Report(const char* label, double ms, double count)
+  {
+    printf("  %-40s %10.3f ms", label, ms);
+    if (count > 0.0)
+      printf("  %10.2f ns/item", (ms * 1000000.0) / count);
+    printf("\n");
+  }
+
+  void ReportThroughput(const char* label, double ms, double bytes, double count, const char* item_name)
+  {
+    double seconds = ms / 1000.0;
+    printf("  %-40s %10.3f ms  %10.1f MB/s  %10.2f M%s/s\n", label, ms,
+           bytes / (1024.0 * 1024.0) / seconds, count / 1000000.0 / seconds, item_name);
+  }
+
+  void DoNotOptimize(double value)
+  {
+    sink = sink + value;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  bool ran = false;
+  for (const Entry& entry : Entries())
+  {
+    if (argc > 1 && strcmp(argv[1], entry.name) != 0)
+      continue;
+    printf("%s\n", entry.name);
+    entry.function(argc > 1 ? argc - 2 : 0, argc > 1 ? argv + 2 : argv + argc);
+    ran = true;
+  }
+
+  if (!ran)
+  {
+    printf("No benchmark named %s, available benchmarks are:\n", argv[1]);
+    for (const Entry& entry : Entries())
+      printf("  %s\n", entry.name);
+    return 1;
+  }
+  return 0;
+}
@@ -1,4 +1,5 @@
 #include "Graphics.h"
+#include "LowLevel/GLState.h"
 #include "../Debug/DebugLog.h"
 
 #include "ImGui/imgui.h"
@@ -8,10 +9,29 @@
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <string>
+#include <cstring>
 
 Graphics GRAPHICS;
 
+const char* const Graphics::COMMAND_DUMP_PATH_ = "../Logs/gl_commands.txt";
+const char* const Graphics::HISTORY_CSV_PATH_ = "../Logs/frame_times.csv";
+const char* const Graphics::HISTORY_JSON_PATH_ = "../Logs/frame_times.json";
+
+// HELPER FUNCTIONS START
+
+//! \return The key of an Object in object_bvh_, the slot of its handle, which stays the same until the Object is deleted.
+static unsigned BvhKey(unsigned id)
+{
+  return id & SlotMap<Object>::INDEX_MASK;
+}
+
+// HELPER FUNCTIONS END
+
 Graphics::Graphics() : window(nullptr)
 {
 
@@ -33,11 +53,12 @@ void Graphics::Initialize()
   viewport.win_width = 1280;
   viewport.win_height = 720;
   viewport.win_ratio = float(viewport.win_width) / float(viewport.win_height);
+  viewport.SetDimensions(0, 0, viewport.win_width, viewport.win_height);
 
-  // Pick GL and GLSL versions
+  // Pick GL and GLSL versions, 3.3 for explicit attribute locations in our shaders
   const char* glsl_version = "#version 130";
   glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 
   // Create window with graphics context
   window = glfwCreateWindow(viewport.win_width, viewport.win_height, "3D Graphics Test", NULL, NULL);
@@ -51,8 +72,19 @@ void Graphics::Initialize()
   LOG_MARKED_IF("glewInit failed", error, '!');
 
   // enable alpha
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  GL_STATE.SetEnabled(GL_BLEND, true);
+  GL_STATE.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  GL_STATE.SetEnabled(GL_DEPTH_TEST, true);
+
+  // models
+  frame_uniforms_.Initialize();
+  mesh_shader_.Compile("Mesh");
+  for (unsigned i = 0; i < RenderThread::SNAPSHOTS; ++i)
+    render_thread_.Snapshot(i).queue.Initialize();
+  models_.Initialize();
+  frame_workers_.reset(new ThreadPool());
+  BuildFrameGraph_();
+  camera.position(0.0f, 0.0f, 5.0f);
 
   // imgui
   IMGUI_CHECKVERSION();
@@ -60,25 +92,52 @@ void Graphics::Initialize()
   ImGui::StyleColorsDark();
   ImGui_ImplGlfw_InitForOpenGL(window, true);
   ImGui_ImplOpenGL3_Init(glsl_version);
+  // normally done by the first ImGui_ImplOpenGL3_NewFrame, which needs the context
+  ImGui_ImplOpenGL3_CreateDeviceObjects();
+
+  // every GL call from here on is made by the render thread
+  glfwMakeContextCurrent(nullptr);
+  render_thread_.Start(window, [this](FrameSnapshot& snapshot) { Render_(snapshot); });
 }
 
-bool Graphics::Update(float& dt)
+bool Graphics::Update(FrameTimer& timer)
 {
-  // create objects
-  while (!obj_to_create_.empty())
-    CreateNextObject_();
-
-  // delete objects
-  while (!obj_to_delete_.empty())
-    DeleteNextObject_();
-
-  Draw_(dt);
+  AllocationSnapshot now = AllocationSnapshot::Take();
+  last_frame_allocations_ = now - frame_start_allocations_;
+  frame_start_allocations_ = now;
+
+  // release last frame's scratch memory before anything this frame uses it
+  frame_arena_.Reset();
+
+  frame_workers_->TakeStats(worker_stats_);
+  
+  // the snapshot comes back with what the render thread did with it two frames ago
+  snapshot_ = &render_thread_.Acquire();
+  models_.Publish(snapshot_->uploaded);
+  snapshot_->uploaded.clear();
+  draw_stats_ = snapshot_->draw_stats;
+  gl_calls_ = snapshot_->gl_calls;
+  
+  timer_ = &timer;
+  frame_graph_.Run(overlap_stages_ ? frame_workers_.get() : nullptr);
+  RecordFrameHistory_();
+  render_thread_.Publish(pipelined_);
   return !glfwWindowShouldClose(window);
 }
 
 void Graphics::Exit()
 {
   // Cleanup
+  render_thread_.Stop();
+  glfwMakeContextCurrent(window);
+  objects_.Clear();
+  frame_workers_.reset();
+  for (unsigned i = 0; i < RenderThread::SNAPSHOTS; ++i)
+    render_thread_.Snapshot(i).queue.Exit();
+  models_.Exit();
+  frame_uniforms_.Exit();
+  GL_STATE.DeleteProgram(mesh_shader_.program);
+
   ImGui_ImplOpenGL3_Shutdown();
   ImGui_ImplGlfw_Shutdown();
   ImGui::DestroyContext();
@@ -87,36 +146,143 @@ void Graphics::Exit()
   glfwTerminate();
 }
 
-void Graphics::CreateObject(const char* obj_file)
+bool Graphics::CreateObject(const char* obj_file)
 {
-  obj_to_create_.push(obj_file);
+  return CreateObjects(&obj_file, 1) == 1;
 }
 
-void Graphics::DeleteObject(unsigned id)
+unsigned Graphics::CreateObjects(const char* const* obj_files, unsigned count)
 {
-  obj_to_delete_.push(id);
+  return object_commands_.PushBulk(count, [obj_files](ObjectCommand_& command, unsigned i)
+  {
+    command.type = ObjectCommand_::Create;
+    command.id = SlotMap<Object>::INVALID_HANDLE;
+    size_t length = strlen(obj_files[i]);
+    LOG_MARKED_IF("CreateObject path truncated: " << obj_files[i], length >= MAX_PATH_LENGTH_, '!');
+    length = length < MAX_PATH_LENGTH_ ? length : MAX_PATH_LENGTH_ - 1;
+    memcpy(command.file, obj_files[i], length);
+    command.file[length] = '\0';
+  });
 }
 
-void Graphics::Draw_(float& dt)
+bool Graphics::DeleteObject(unsigned id)
 {
-  glfwPollEvents();
+  return DeleteObjects(&id, 1) == 1;
+}
 
-  // Start the Dear ImGui frame
-  ImGui_ImplOpenGL3_NewFrame();
-  ImGui_ImplGlfw_NewFrame();
-  ImGui::NewFrame();
+unsigned Graphics::DeleteObjects(const unsigned* ids, unsigned count)
+{
+  return object_commands_.PushBulk(count, [ids](ObjectCommand_& command, unsigned i)
+  {
+    command.type = ObjectCommand_::Delete;
+    command.id = ids[i];
+    command.file[0] = '\0';
+  });
+}
+
+Object* Graphics::FindObject(unsigned id)
+{
+  return objects_.Get(id);
+}
 
-  // draw objects
-  for (auto it = objects_.begin(); it != objects_.end(); ++it)
-    it->second->Draw();
+void Graphics::BuildFrameGraph_()
+{
+  // declared in the order they would run one after another, the graph overlaps what it can
+  frame_graph_.AddStage("Commands", TaskGraph::MainThread, 0, ObjectData | TransformData | ModelData | BvhData | RegistryData | ArenaData, [this]()
+  {
+    ApplyObjectCommands_();
+  });
+  frame_graph_.AddStage("Input", TaskGraph::MainThread, 0, InputData | ImGuiData, [this]()
+  {
+    glfwPollEvents();
+    snapshot_->input_time = std::chrono::steady_clock::now();
+    ImGui_ImplGlfw_NewFrame();
+    ImGui::NewFrame();
+  });
+  frame_graph_.AddStage("Simulate", TaskGraph::AnyThread, 0, SimulationData, [this]()
+  {
+    while (timer_->Step())
+      Simulate_(timer_->StepSeconds());
+  });
+  frame_graph_.AddStage("Camera", TaskGraph::AnyThread, InputData | SimulationData, CameraData, [this]()
+  {
+    camera.Update(viewport.ratio);
+    // drawn between the last two steps, so motion stays smooth when frames and steps do not line up
+    double time = previous_time_ + (time_ - previous_time_) * double(timer_->Alpha());
+    FrameUniformBuffer::Compute(snapshot_->uniforms, camera, viewport, float(time));
+  });
+  frame_graph_.AddStage("Transforms", TaskGraph::AnyThread, 0, TransformData, [this]()
+  {
+    transforms_.Update(frame_workers_.get());
+  });
+  frame_graph_.AddStage("Cull", TaskGraph::AnyThread, CameraData | ModelData | TransformData, ObjectData | BvhData | QueueData | ArenaData, [this]()
+  {
+    CullObjects_(camera.ProjectionScale(float(viewport.win_height)));
+  });
+  frame_graph_.AddStage("Pick", TaskGraph::MainThread, InputData | ImGuiData | CameraData | BvhData | ObjectData, PickData, [this]()
+  {
+    // pick on clicks ImGui did not take, after culling so the tree matches what is drawn
+    if (ImGui::IsMouseClicked(0) && !ImGui::GetIO().WantCaptureMouse)
+    {
+      double mouse_x, mouse_y;
+      glfwGetCursorPos(window, &mouse_x, &mouse_y);
+      picked_id_ = PickObject(mouse_x, mouse_y);
+    }
+  });
+  // shows the draw counts the render thread last sent back, so it need not wait for this frame's
+  frame_graph_.AddStage("ImGui", TaskGraph::MainThread, ModelData | CameraData | BvhData | PickData | RegistryData | SimulationData, ImGuiData | ObjectData | TransformData, [this]()
+  {
+    BuildImGui_();
+  });
+  frame_graph_.AddStage("Sort", TaskGraph::AnyThread, 0, QueueData, [this]()
+  {
+    snapshot_->queue.Prepare(frame_workers_.get());
+  });
+  frame_graph_.AddStage("Snapshot", TaskGraph::MainThread, QueueData, ImGuiData, [this]()
+  {
+    Snapshot_();
+  });
+  
+  frame_history_.AddColumn("Frame");
+  frame_history_.AddColumn("Update");
+  for (unsigned stage = 0; stage < frame_graph_.StageCount(); ++stage)
+    frame_history_.AddColumn(frame_graph_.StageName(stage));
+}
 
-  // draw imgui
+void Graphics::BuildImGui_()
+{
   if (ImGui::BeginMainMenuBar())
   {
     if (ImGui::BeginMenu("Info"))
     {
-      ImGui::Value("FPS", 1.0f / dt);
-      ImGui::Value("Delta Time", dt);
+      double frame_seconds = timer_->FrameSeconds();
+      ImGui::Text("FPS: %.1f (%.3f ms)", frame_seconds > 0.0 ? 1.0 / frame_seconds : 0.0, frame_seconds * 1000.0);
+      ImGui::Text("Fixed steps: %u this frame at %.1f Hz, alpha %.2f", timer_->StepsThisFrame(), 1.0 / timer_->StepSeconds(), timer_->Alpha());
+      ImGui::Text("Spikes clamped: %u", timer_->Spikes());
+      ImGui::Text("Models: %u (%u loading)", models_.MeshCount(), models_.Pending());
+      ImGui::Text("Objects: %u visible of %u (%u culled)", visible_count_, objects_.Size(), objects_.Size() - visible_count_);
+      const TransformHierarchy::Stats& transform_stats = transforms_.LastStats();
+      ImGui::Text("Transforms: %u recomputed of %u, %u levels", transform_stats.recomputed, transforms_.Size(), transform_stats.levels);
+      ImGui::Text("BVH: %zu nodes, %u builds", object_bvh_.NodeCount(), bvh_builds_);
+      ImGui::Checkbox("Occlusion culling", &occlusion_enabled_);
+      const OcclusionBuffer::Stats& occlusion_stats = occlusion_.LastStats();
+      ImGui::Text("Occluded: %u by %u occluders, %u triangles", occluded_count_, occlusion_stats.occluders, occlusion_stats.triangles);
+      ImGui::Text("Occlusion time: %.3f ms (%.3f ms rasterizing)", occlusion_ms_, occlusion_stats.rasterize_ms);
+      Object* picked = FindObject(picked_id_);
+      ImGui::Text("Picked: %s", picked ? picked->name_.c_str() : "none");
+      ImGui::Text("Draw calls: %u (%u saved by instancing)", draw_stats_.draw_calls, draw_stats_.DrawCallsSaved());
+      ImGui::Text("Shader changes: %u, transparent draws: %u", draw_stats_.shader_changes, draw_stats_.transparent);
+      ImGui::Text("Triangles: %u", draw_stats_.triangles);
+      ImGui::Text("GL commands: %u recorded, %zu bytes", draw_stats_.commands, draw_stats_.command_bytes);
+      ImGui::SameLine();
+      if (ImGui::SmallButton("Dump"))
+        dump_commands_ = true;
+      ImGui::Text("GL state calls: %u issued, %u skipped", gl_calls_.issued, gl_calls_.skipped);
+      DrawAllocationInfo_();
+      DrawWorkerInfo_();
+      DrawStageInfo_();
+      DrawRenderThreadInfo_();
+      DrawFrameHistoryInfo_();
       ImGui::EndMenu();
     }
 
@@ -125,7 +291,7 @@ void Graphics::Draw_(float& dt)
       for (auto it = imgui_draw_.begin(); it != imgui_draw_.end(); ++it)
       {
         ImGui::PushID(*it); // use the address as a unique id
-        if ((*it)->create_window_ && ImGui::BeginMenu((*it)->name_))
+        if ((*it)->create_window_ && ImGui::BeginMenu((*it)->name_.c_str()))
         {
           (*it)->DrawImGui();
           ImGui::EndMenu();
@@ -139,32 +305,345 @@ void Graphics::Draw_(float& dt)
 
   for (auto it = imgui_draw_.begin(); it != imgui_draw_.end(); ++it)
     (*it)->DrawImGui();
+}
 
-  // Rendering
+void Graphics::Snapshot_()
+{
+  // ImGui's draw data is rebuilt by the next NewFrame, while the render thread may still be drawing it
   ImGui::Render();
-  int display_w, display_h;
-  glfwGetFramebufferSize(window, &display_w, &display_h);
-  glViewport(0, 0, display_w, display_h);
-  ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+  snapshot_->imgui.Copy(*ImGui::GetDrawData());
+  glfwGetFramebufferSize(window, &snapshot_->display_width, &snapshot_->display_height);
+  
+  if (dump_commands_)
+  {
+    std::ofstream file(COMMAND_DUMP_PATH_);
+    snapshot_->queue.Dump(file);
+    LOG("GL commands written to " << COMMAND_DUMP_PATH_);
+    dump_commands_ = false;
+  }
+}
+
+void Graphics::Render_(FrameSnapshot& snapshot)
+{
+  GL_STATE.EndFrame();
+  models_.UploadFinished(UPLOAD_BUDGET_, snapshot.uploaded);
+  frame_uniforms_.Upload(snapshot.uniforms);
+  snapshot.queue.Flush();
+  snapshot.draw_stats = snapshot.queue.LastStats();
+  
+  GL_STATE.Viewport(0, 0, snapshot.display_width, snapshot.display_height);
+  ImGui_ImplOpenGL3_RenderDrawData(snapshot.imgui.Data());
+  // the ImGui renderer sets state directly
+  GL_STATE.Invalidate();
+  snapshot.gl_calls = GL_STATE.LastFrame();
 
   glfwSwapBuffers(window);
   glClearColor(0.0f, 0.0f, 0.0f, 1.0f);// black
-  glClear(GL_COLOR_BUFFER_BIT);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
   GLenum err = glGetError();
   LOG_MARKED_IF("GraphicsController::Update caught glError " << err << ", you should add checks to your code to find the exact point of failure", err != 0, '!');
 }
 
-void Graphics::CreateNextObject_()
+void Graphics::CullObjects_(float projection_scale)
+{
+  UpdateBvh_();
+  unsigned* visible = frame_arena_.AllocateArray<unsigned>(objects_.Size() + 1);
+  visible_count_ = object_bvh_.CullFrustum(camera.GetFrustum(), visible);
+  for (unsigned i = 0; i < visible_count_; ++i)
+    visible[i] = objects_.IndexOf(visible[i]);
+  if (occlusion_enabled_)
+    visible_count_ = OccludeObjects_(visible, visible_count_);
+  else
+    occluded_count_ = 0;
+  for (unsigned i = 0; i < visible_count_; ++i)
+    objects_[visible[i]].Draw(snapshot_->queue, mesh_shader_, camera, projection_scale);
+}
+
+void Graphics::UpdateBvh_()
+{
+  // each Object's bounds are independent, so they are recomputed across the workers
+  unsigned char* changed = frame_arena_.AllocateArray<unsigned char>(objects_.Size() + 1);
+  frame_workers_->ParallelFor(0, objects_.Size(), BOUNDS_GRAIN_, [this, changed](unsigned begin, unsigned end)
+  {
+    for (unsigned i = begin; i < end; ++i)
+      changed[i] = objects_[i].UpdateBounds();
+  });
+  
+  // Objects join the tree once their mesh has loaded and they have a box
+  unsigned inserts = 0;
+  for (unsigned i = 0; i < objects_.Size(); ++i)
+    inserts += !object_bvh_.Contains(BvhKey(objects_[i].id)) && !objects_[i].WorldBounds().IsEmpty();
+  
+  // inserting more than the tree holds, such as the first frame, costs more than building
+  if (object_bvh_.NeedsRebuild() || inserts > object_bvh_.Size())
+  {
+    unsigned* keys = frame_arena_.AllocateArray<unsigned>(objects_.Size() + 1);
+    Aabb* bounds = frame_arena_.AllocateArray<Aabb>(objects_.Size() + 1);
+    unsigned count = 0;
+    for (unsigned i = 0; i < objects_.Size(); ++i)
+      if (!objects_[i].WorldBounds().IsEmpty())
+      {
+        keys[count] = BvhKey(objects_[i].id);
+        bounds[count++] = objects_[i].WorldBounds();
+      }
+    object_bvh_.Build(keys, bounds, count);
+    ++bvh_builds_;
+    return;
+  }
+  
+  for (unsigned i = 0; i < objects_.Size(); ++i)
+  {
+    unsigned key = BvhKey(objects_[i].id);
+    if (object_bvh_.Contains(key))
+    {
+      if (changed[i])
+        object_bvh_.Update(key, objects_[i].WorldBounds());
+    }
+    else if (!objects_[i].WorldBounds().IsEmpty())
+      object_bvh_.Insert(key, objects_[i].WorldBounds());
+  }
+  object_bvh_.Refit();
+}
+
+unsigned Graphics::OccludeObjects_(unsigned* visible, unsigned count)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  occluded_count_ = 0;
+  occlusion_.Begin(camera.ViewProjection());
+  for (unsigned i = 0; i < count; ++i)
+  {
+    const Object& object = objects_[visible[i]];
+    if (object.occluder && object.mesh->IsReady())
+      occlusion_.AddOccluder(object.Model(), object.mesh->occluder_positions.data(), object.mesh->occluder_indices.data(), unsigned(object.mesh->occluder_indices.size()));
+  }
+  if (!occlusion_.LastStats().triangles)
+  {
+    occlusion_ms_ = 0.0f;
+    return count;
+  }
+  
+  occlusion_.Rasterize(frame_workers_.get());
+  unsigned kept = 0;
+  for (unsigned i = 0; i < count; ++i)
+  {
+    // occluders would hide themselves
+    const Object& object = objects_[visible[i]];
+    if (object.occluder || occlusion_.IsVisible(object.WorldBounds()))
+      visible[kept++] = visible[i];
+  }
+  occluded_count_ = count - kept;
+  occlusion_ms_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return kept;
+}
+
+unsigned Graphics::PickObject(double x, double y)
+{
+  // GetRelativePosition works from the lower left, in the same units as the window size
+  int window_y = viewport.win_height - int(y);
+  if (!viewport.IsInside(int(x), window_y))
+    return SlotMap<Object>::INVALID_HANDLE;
+  float relative_x, relative_y;
+  viewport.GetRelativePosition(int(x), window_y, &relative_x, &relative_y);
+  
+  float origin[3], direction[3];
+  camera.ScreenRay(2.0f * relative_x / viewport.ratio - 1.0f, 2.0f * relative_y - 1.0f, origin, direction);
+  unsigned key;
+  float distance;
+  if (!object_bvh_.Raycast(origin, direction, key, distance))
+    return SlotMap<Object>::INVALID_HANDLE;
+  return objects_[objects_.IndexOf(key)].id;
+}
+
+void Graphics::DrawWorkerInfo_()
+{
+  ImGui::Separator();
+  if (!ImGui::TreeNode("Workers"))
+    return;
+  
+  // the main thread helps from Wait, so it is listed with the workers
+  for (unsigned i = 0; i < worker_stats_.size(); ++i)
+  {
+    const ThreadPool::WorkerStats& stats = worker_stats_[i];
+    ImGui::ProgressBar(stats.utilization, ImVec2(120.0f, 0.0f));
+    ImGui::SameLine();
+    if (i)
+      ImGui::Text("Worker %u: %u tasks, %u stolen", i, stats.tasks, stats.steals);
+    else
+      ImGui::Text("Main: %u tasks, %u stolen", stats.tasks, stats.steals);
+  }
+  ImGui::TreePop();
+}
+
+void Graphics::DrawStageInfo_()
+{
+  ImGui::Separator();
+  if (!ImGui::TreeNode("Frame stages"))
+    return;
+  
+  ImGui::Checkbox("Overlap stages", &overlap_stages_);
+  ImGui::Text("Last frame: %.3f ms, critical path %.3f ms", frame_graph_.LastRunMs(), frame_graph_.CriticalPathMs());
+  for (unsigned stage = 0; stage < frame_graph_.StageCount(); ++stage)
+  {
+    const TaskGraph::Timing& timing = frame_graph_.LastTiming(stage);
+    // critical stages are marked, they are what a faster frame has to shorten
+    ImGui::Text("%c %-10s %7.3f ms at %7.3f ms on %s", timing.critical ? '*' : ' ', frame_graph_.StageName(stage), timing.duration_ms, timing.start_ms, timing.on_main_thread ? "main" : "worker");
+  }
+  ImGui::TreePop();
+}
+
+void Graphics::DrawRenderThreadInfo_()
+{
+  ImGui::Separator();
+  if (!ImGui::TreeNode("Render thread"))
+    return;
+  
+  // off, each frame is drawn before the next one starts, as on a single thread
+  ImGui::Checkbox("Pipeline update and render", &pipelined_);
+  const RenderThread::Stats& stats = render_thread_.GetStats();
+  ImGui::Text("Update: %.3f ms, render: %.3f ms", frame_graph_.LastRunMs(), stats.render_ms);
+  ImGui::Text("Waiting for the render thread: %.3f ms", stats.wait_ms);
+  ImGui::Text("Input to present latency: %.3f ms", stats.latency_ms);
+  ImGui::Text("Present interval: %.3f ms (%.1f FPS)", stats.frame_ms, stats.frame_ms > 0.0f ? 1000.0f / stats.frame_ms : 0.0f);
+  ImGui::TreePop();
+}
+
+void Graphics::RecordFrameHistory_()
+{
+  float values[FrameHistory::MAX_COLUMNS];
+  unsigned columns = frame_history_.ColumnCount();
+  values[0] = float(timer_->FrameSeconds() * 1000.0);
+  values[1] = frame_graph_.LastRunMs();
+  for (unsigned column = 2; column < columns; ++column)
+    values[column] = frame_graph_.LastTiming(column - 2).duration_ms;
+  frame_history_.Record(values);
+}
+
+void Graphics::DrawFrameHistoryInfo_()
+{
+  ImGui::Separator();
+  if (!ImGui::TreeNode("Frame times"))
+    return;
+  
+  frame_history_.Read(history_rows_);
+  unsigned columns = frame_history_.ColumnCount();
+  FrameHistory::Percentiles frame = frame_history_.Summarize(history_rows_, 0, history_scratch_);
+  
+  // frame times over time, oldest first, the values are interleaved by frame so the stride skips the other columns
+  char overlay[64];
+  snprintf(overlay, sizeof(overlay), "%u frames, p99 %.2f ms, max %.2f ms", history_rows_.Count(), frame.p99, frame.max);
+  if (history_rows_.Count())
+  {
+    ImGui::PlotLines("##FrameTimes", history_rows_.values.data(), int(history_rows_.Count()), 0, overlay, 0.0f, frame.max, ImVec2(0.0f, 80.0f), int(columns * sizeof(float)));
+    
+    // frames per fixed width bin, the shape shows a second mode of slow frames that percentiles blur
+    float bins[HISTOGRAM_BINS_] = {};
+    float peak = 0.0f;
+    for (unsigned row = 0; row < history_rows_.Count(); ++row)
+    {
+      unsigned bin = std::min(HISTOGRAM_BINS_ - 1, unsigned(history_rows_.values[row * columns] / HISTOGRAM_BIN_MS_));
+      peak = std::max(peak, ++bins[bin]);
+    }
+    snprintf(overlay, sizeof(overlay), "frames per %g ms, last bar %g+ ms", HISTOGRAM_BIN_MS_, HISTOGRAM_BIN_MS_ * (HISTOGRAM_BINS_ - 1));
+    ImGui::PlotHistogram("##FrameTimeHistogram", bins, int(HISTOGRAM_BINS_), 0, overlay, 0.0f, peak, ImVec2(0.0f, 80.0f));
+  }
+  
+  ImGui::Text("%-10s %8s %8s %8s %8s", "ms", "p50", "p95", "p99", "max");
+  for (unsigned column = 0; column < columns; ++column)
+  {
+    FrameHistory::Percentiles summary = frame_history_.Summarize(history_rows_, column, history_scratch_);
+    ImGui::Text("%-10s %8.3f %8.3f %8.3f %8.3f", frame_history_.ColumnName(column), summary.p50, summary.p95, summary.p99, summary.max);
+  }
+  
+  if (ImGui::Button("Export CSV"))
+  {
+    std::ofstream file(HISTORY_CSV_PATH_);
+    frame_history_.WriteCsv(file);
+    LOG("Frame times written to " << HISTORY_CSV_PATH_);
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Export JSON"))
+  {
+    std::ofstream file(HISTORY_JSON_PATH_);
+    frame_history_.WriteJson(file);
+    LOG("Frame times written to " << HISTORY_JSON_PATH_);
+  }
+  ImGui::TreePop();
+}
+
+void Graphics::DrawAllocationInfo_()
+{
+  ImGui::Separator();
+  ImGui::Text("Heap allocs/frees last frame: %llu / %llu", last_frame_allocations_.heap_allocations, last_frame_allocations_.heap_frees);
+  ImGui::Text("Pool allocs/frees last frame: %llu / %llu", last_frame_allocations_.pool_allocations, last_frame_allocations_.pool_frees);
+  ImGui::Text("Heap allocs total: %llu", ALLOCATION_COUNTERS.heap_allocations.load());
+  ImGui::Text("Frame arena: %zu / %zu bytes", frame_arena_.LastFrameBytes(), frame_arena_.Capacity());
+  
+  if (ImGui::TreeNode("Pools"))
+  {
+    for (size_t i = 0; const PoolAllocator* pool = Pool::SizeClass(i); ++i)
+      if (pool->Chunks())
+        ImGui::Text("%4zu bytes: %zu live / %zu blocks", pool->BlockSize(), pool->LiveBlocks(), pool->Capacity());
+    ImGui::TreePop();
+  }
+}
+
+void Graphics::Simulate_(double step)
 {
-  const char* file = obj_to_create_.top();
-  Object* obj = new Object(next_id_++);
-  // object serialization here
-  obj_to_create_.pop();
+  previous_time_ = time_;
+  time_ += step;
 }
 
-void Graphics::DeleteNextObject_()
+void Graphics::ApplyObjectCommands_()
 {
-  objects_.erase(objects_.find(obj_to_delete_.top()));
-  obj_to_delete_.pop();
+  unsigned count = object_commands_.SizeApprox();
+  if (!count)
+    return;
+
+  // one allocation for the whole batch, released with the frame arena
+  ObjectCommand_* batch = frame_arena_.AllocateArray<ObjectCommand_>(count);
+  count = object_commands_.Pop(batch, count);
+
+  unsigned creations = 0;
+  for (unsigned i = 0; i < count; ++i)
+    creations += batch[i].type == ObjectCommand_::Create;
+
+  // grow object storage and the ImGui hash table once for every creation
+  if (creations)
+  {
+    unsigned needed = objects_.Size() + creations;
+    if (needed > objects_.Capacity())
+      objects_.Reserve(needed > objects_.Capacity() * 2 ? needed : objects_.Capacity() * 2);
+    imgui_draw_.reserve(imgui_draw_.size() + creations);
+  }
+
+  // create before deleting, as requests were handled before batching
+  for (unsigned i = 0; i < count; ++i)
+    if (batch[i].type == ObjectCommand_::Create)
+      CreateObject_(batch[i].file);
+
+  for (unsigned i = 0; i < count; ++i)
+    if (batch[i].type == ObjectCommand_::Delete)
+    {
+      Object* object = objects_.Get(batch[i].id);
+      LOG_MARKED_IF("DeleteObject was given stale id " << batch[i].id, !object, '!');
+      if (!object)
+        continue;
+      // children of the Object become roots, keeping their local transforms
+      transforms_.Destroy(object->Transform());
+      if (object_bvh_.Contains(BvhKey(batch[i].id)))
+        object_bvh_.Remove(BvhKey(batch[i].id));
+      objects_.Remove(batch[i].id);
+    }
+}
+
+void Graphics::CreateObject_(const char* file)
+{
+  unsigned id = objects_.Emplace(objects_.NextHandle(), &transforms_);
+  if (id == SlotMap<Object>::INVALID_HANDLE)
+  {
+    LOG_MARKED("Object limit reached, " << file << " was not created", '!');
+    return;
+  }
+  objects_.Get(id)->mesh = models_.Load(file);
 }
\ No newline at end of file
@@ -7,11 +7,28 @@
 
 #include "Object.h"
 #include "ImGuiDraw.h"
+#include "RenderQueue.h"
+#include "RenderThread.h"
+#include "TransformHierarchy.h"
 #include "LowLevel/Viewport.h"
+#include "LowLevel/Camera.h"
+#include "LowLevel/Shader.h"
+#include "LowLevel/FrameUniforms.h"
+#include "Model/ModelLoader.h"
+#include "../Math/Bvh.h"
+#include "../Math/OcclusionBuffer.h"
+#include "../Memory/SlotMap.h"
+#include "../Memory/PoolAllocator.h"
+#include "../Memory/FrameArena.h"
+#include "../Memory/AllocationCounters.h"
+#include "../Threading/MpscQueue.h"
+#include "../Threading/TaskGraph.h"
+#include "../Threading/ThreadPool.h"
+#include "../Time/FrameHistory.h"
+#include "../Time/FrameTimer.h"
 
-#include <unordered_map>
+#include <memory>
 #include <unordered_set>
-#include <stack>
 
 struct GLFWwindow;
 
@@ -25,39 +42,235 @@ class Graphics
     //! \brief Initializes OpenGL and ImGui.
     void Initialize();
 
-    /*! \brief Handles object changes and calls Draw_.
-        \param dt The delta time of the current frame, the fraction of a second it will take to run.
+    /*! \brief Runs the stages of a frame, from object changes to handing it to the render thread.
+        \param timer Ticked for this frame, the simulation takes the fixed steps it has due.
         \return True if the program should keep running
     */
-    bool Update(float& dt);
+    bool Update(FrameTimer& timer);
 
-    //! \brief Shuts down OpenGL and ImGui.
+    //! \brief Frees models and shuts down OpenGL and ImGui.
     void Exit();
     
-    /*! \brief Requests an Object be created next frame
-        \param obj_file The file with the model data to be used.
-    */
-    void CreateObject(const char* obj_file);
-    /*! \brief Requests an object be deleted next frame
-        \param id The unique id of the Object to be deleted.
+    /*! \brief Requests an Object be created next frame, callable from any thread.
+        
+        The model is imported in the background, the Object exists right away
+        but is not drawn until its Mesh is Ready.
+        \param obj_file The OBJ file relative to MODEL_FOLDER_PATH, copied so it need not outlive the call.
+        \return False if the request queue is full, try again next frame.
     */
+    bool CreateObject(const char* obj_file);
+    
+    /*! \brief Requests several Objects be created next frame, callable from any thread.
 
-    void DeleteObject(unsigned id);
+        Takes a pointer and count rather than a span, std::span is C++20 and the project builds as C++17.
+        \param obj_files The files with the model data to be used, copied so they need not outlive the call.
+        \param count The number of files.
+        \return The number of requests queued, the rest should be retried next frame.
+    */
+    unsigned CreateObjects(const char* const* obj_files, unsigned count);
+    
+    /*! \brief Requests an object be deleted next frame, callable from any thread.
+        \param id The unique id of the Object to be deleted, stale ids are ignored.
+        \return False if the request queue is full, try again next frame.
+    */
+    bool DeleteObject(unsigned id);
+    
+    /*! \brief Requests several objects be deleted next frame, callable from any thread.
+        \param ids The unique ids of the Objects to be deleted, stale ids are ignored.
+        \param count The number of ids.
+        \return The number of requests queued, the rest should be retried next frame.
+    */
+    unsigned DeleteObjects(const unsigned* ids, unsigned count);
+    
+    /*! \brief Returns a live Object.
+        \param id The unique id of the Object.
+        \return The Object, or nullptr if the id is stale. Only valid until objects are next created or deleted.
+    */
+    Object* FindObject(unsigned id);
+    
+    /*! \brief Finds the Object whose bounding box is under a window position.
+        \param x The window x position in screen coordinates, from the left.
+        \param y The window y position in screen coordinates, from the top, as GLFW reports the cursor.
+        \return The id of the nearest Object hit, or SlotMap<Object>::INVALID_HANDLE.
+    */
+    unsigned PickObject(double x, double y);
 
     GLFWwindow* window;
     Viewport viewport;
+    Camera camera;
 
   private:
-    unsigned next_id_ = 0;
-    std::unordered_set<ImGuiDraw*> imgui_draw_;
-    std::unordered_map<unsigned, Object*> objects_;
-    std::stack<const char*> obj_to_create_;
-    std::stack<unsigned> obj_to_delete_;
+    //! Longest model path CreateObject accepts, matches the Windows MAX_PATH.
+    static const unsigned MAX_PATH_LENGTH_ = 260;
+    //! Number of create/delete requests that may wait for the next frame.
+    static const unsigned COMMAND_CAPACITY_ = 4096;
+    //! Bytes of finished model imports uploaded per frame.
+    static const size_t UPLOAD_BUDGET_ = 16 * 1024 * 1024;
+    //! Objects whose bounds each worker task updates.
+    static const unsigned BOUNDS_GRAIN_ = 2048;
+    //! File the recorded GL commands of a frame are written to on request.
+    static const char* const COMMAND_DUMP_PATH_;
+    //! Files the frame history is exported to on request.
+    static const char* const HISTORY_CSV_PATH_;
+    static const char* const HISTORY_JSON_PATH_;
+    //! Width of each bar of the frame time histogram, in milliseconds.
+    static constexpr float HISTOGRAM_BIN_MS_ = 1.0f;
+    //! Bars of the frame time histogram, the last also counts every longer frame.
+    static const unsigned HISTOGRAM_BINS_ = 34;
+    
+    //! Data the stages of a frame read and write, bits of TaskGraph masks.
+    enum FrameData_ : unsigned
+    {
+      ObjectData = 1u << 0,
+      TransformData = 1u << 1,
+      ModelData = 1u << 2,
+      CameraData = 1u << 3,
+      InputData = 1u << 4,
+      ImGuiData = 1u << 5,
+      BvhData = 1u << 6,
+      PickData = 1u << 7,
+      //! The render queue's packets.
+      QueueData = 1u << 8,
+      //! The set of ImGuiDraw instances.
+      RegistryData = 1u << 9,
+      ArenaData = 1u << 10,
+      //! State advanced in fixed steps, and the timer handing them out.
+      SimulationData = 1u << 11
+    };
+    
+    //! A create or delete request waiting for Update.
+    struct ObjectCommand_
+    {
+      enum Type { Create, Delete } type;
+      //! The Object to delete.
+      unsigned id;
+      //! The model of the Object to create.
+      char file[MAX_PATH_LENGTH_];
+    };
+  
+    std::unordered_set<ImGuiDraw*, std::hash<ImGuiDraw*>, std::equal_to<ImGuiDraw*>, PoolStlAllocator<ImGuiDraw*>> imgui_draw_;
+    SlotMap<Object> objects_;
+    //! Local and world transforms of every Object, updated before culling.
+    TransformHierarchy transforms_;
+    ModelLoader models_;
+    Shader mesh_shader_;
+    //! Camera and viewport values every shader reads, uploaded once per frame by the render thread.
+    FrameUniformBuffer frame_uniforms_;
+    //! Simulated seconds since Initialize after the last fixed step, and before it, interpolated for the time uniform.
+    double time_ = 0.0;
+    double previous_time_ = 0.0;
+    //! Owns the GL context after Initialize and draws the frames Update publishes.
+    RenderThread render_thread_;
+    //! The snapshot the current Update fills, its render queue batches object draws into instanced draws.
+    FrameSnapshot* snapshot_ = nullptr;
+    //! Overlaps updating a frame with drawing the last one, off waits for each frame to be drawn.
+    bool pipelined_ = true;
+    //! Set from the Info menu to write this frame's GL commands to COMMAND_DUMP_PATH_.
+    bool dump_commands_ = false;
+    //! Results of the last frame the render thread drew, for the Info menu.
+    RenderQueue::Stats draw_stats_;
+    GLState::Counters gl_calls_;
+    //! Boxes of every Object keyed by the slot index of its handle, for culling and picking.
+    Bvh object_bvh_;
+    //! Times the tree was built since Initialize.
+    unsigned bvh_builds_ = 0;
+    //! Visible Objects of the last frame.
+    unsigned visible_count_ = 0;
+    //! Hides Objects behind Objects marked as occluders.
+    OcclusionBuffer occlusion_;
+    bool occlusion_enabled_ = true;
+    //! Objects hidden by occluders last frame.
+    unsigned occluded_count_ = 0;
+    //! Time spent on occlusion culling last frame, including rasterization.
+    float occlusion_ms_ = 0.0f;
+    //! Workers for per-frame jobs, separate from the model import workers so waiting on them never runs an import.
+    std::unique_ptr<ThreadPool> frame_workers_;
+    //! Work of the main thread and each frame worker over the last frame.
+    std::vector<ThreadPool::WorkerStats> worker_stats_;
+    //! The stages of Update, built once in Initialize.
+    TaskGraph frame_graph_;
+    //! Runs independent stages at once, off runs them in declared order for comparison.
+    bool overlap_stages_ = true;
+    //! The timer given to the current Update, for the stages.
+    FrameTimer* timer_ = nullptr;
+    //! Frame time, update time, then the time of each stage, for the last FrameHistory::CAPACITY frames.
+    FrameHistory frame_history_;
+    //! Reused by the Info menu to read and summarize frame_history_.
+    FrameHistory::Rows history_rows_;
+    std::vector<float> history_scratch_;
+    //! The Object last clicked on, INVALID_HANDLE if none.
+    unsigned picked_id_ = SlotMap<Object>::INVALID_HANDLE;
+    
+    //! Per-frame scratch memory, released in bulk at the start of each Update.
+    FrameArena frame_arena_;
+    //! Allocation totals at the start of the current frame.
+    AllocationSnapshot frame_start_allocations_;
+    //! Allocations made during the last full frame.
+    AllocationSnapshot last_frame_allocations_;
+    //! Create/delete requests from any thread, drained once per frame.
+    MpscQueue<ObjectCommand_, COMMAND_CAPACITY_> object_commands_;
 
-    void Draw_(float& dt);
+    //! \brief Declares the stages of Update and the data each reads and writes.
+    void BuildFrameGraph_();
+    
+    //! \brief Builds the menus and every ImGuiDraw window.
+    void BuildImGui_();
+    
+    /*! \brief Draws a snapshot and swaps buffers, called on the render thread.
+        \param snapshot The frame to draw, the render thread writes its results back into it.
+    */
+    void Render_(FrameSnapshot& snapshot);
+    
+    //! \brief Copies what the render thread needs from ImGui into the snapshot, and dumps its commands if requested.
+    void Snapshot_();
+    
+    /*! \brief Updates object_bvh_, then queues the Objects in the camera frustum.
+        \param projection_scale Pixels per unit at a distance of one unit, for picking levels of detail.
+    */
+    void CullObjects_(float projection_scale);
+    
+    //! \brief Inserts new Objects into object_bvh_ and refits it for moved ones, building it again when degraded.
+    void UpdateBvh_();
+    
+    /*! \brief Rasterizes the visible occluders and removes the Objects they hide.
+        \param visible Packed indices of the Objects in the frustum, compacted in place.
+        \param count The number of indices.
+        \return The number of indices left.
+    */
+    unsigned OccludeObjects_(unsigned* visible, unsigned count);
+    
+    //! \brief Displays heap, pool, and frame arena counters in the Info menu.
+    void DrawAllocationInfo_();
+    
+    //! \brief Displays how busy the main thread and each frame worker were in the Info menu.
+    void DrawWorkerInfo_();
+    
+    //! \brief Displays the timing of every frame stage and the critical path in the Info menu.
+    void DrawStageInfo_();
+    
+    //! \brief Displays update, render, and latency timings of the render thread in the Info menu.
+    void DrawRenderThreadInfo_();
+    
+    //! \brief Displays a plot and percentiles of recent frame times in the Info menu, with export buttons.
+    void DrawFrameHistoryInfo_();
+    
+    //! \brief Records the timings of the frame that just ran into frame_history_.
+    void RecordFrameHistory_();
 
-    void CreateNextObject_();
-    void DeleteNextObject_();
+    /*! \brief Advances the simulation by one fixed step.
+        \param step Seconds per step.
+    */
+    void Simulate_(double step);
+    
+    /*! \brief Drains every pending request in one batch, growing storage once
+               for all creations before applying them.
+    */
+    void ApplyObjectCommands_();
+    
+    /*! \brief Creates an Object, storage must already have room for it.
+        \param file The file with the model data to be used.
+    */
+    void CreateObject_(const char* file);
 };
 
 extern Graphics GRAPHICS;
\ No newline at end of file
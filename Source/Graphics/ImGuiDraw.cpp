@@ -1,17 +1,29 @@
 #include "ImGuiDraw.h"
 #include "Graphics.h"
 
-ImGuiDraw::ImGuiDraw() : name_(nullptr), create_window_(false)
+ImGuiDraw::ImGuiDraw() : name_(), create_window_(false)
 {
   // should never be called due to private nature
 }
 
-ImGuiDraw::ImGuiDraw(const char* name, bool create_window) : name_(name), create_window_(create_window)
+ImGuiDraw::ImGuiDraw(const char* name, bool create_window) : name_(name ? name : ""), create_window_(create_window)
 {
   GRAPHICS.imgui_draw_.emplace(this);
 }
 
+ImGuiDraw::ImGuiDraw(const ImGuiDraw& rhs) : name_(rhs.name_), create_window_(rhs.create_window_)
+{
+  GRAPHICS.imgui_draw_.emplace(this);
+}
+
+ImGuiDraw& ImGuiDraw::operator=(const ImGuiDraw& rhs)
+{
+  name_ = rhs.name_;
+  create_window_ = rhs.create_window_;
+  return *this;
+}
+
 ImGuiDraw::~ImGuiDraw()
 {
-  GRAPHICS.imgui_draw_.erase(GRAPHICS.imgui_draw_.find(this));
-}
\ No newline at end of file
+  GRAPHICS.imgui_draw_.erase(this);
+}
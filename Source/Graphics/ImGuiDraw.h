@@ -5,16 +5,31 @@
 */
 #pragma once
 
+#include <string>
+
 class ImGuiDraw
 {
   friend class Graphics;
   ImGuiDraw();
 
-  const char* name_;
-  const bool create_window_;
+  std::string name_;
+  bool create_window_;
 
   public:
     ImGuiDraw(const char* name, bool create_window = true);
-    ~ImGuiDraw();
+    
+    /*! \brief Copies the name and registers the new address with Graphics, so
+               derived classes may live in containers that move them.
+        \param rhs The ImGuiDraw to copy from.
+    */
+    ImGuiDraw(const ImGuiDraw& rhs);
+    
+    /*! \brief Copies the name, the registration of this address is unchanged.
+        \param rhs The ImGuiDraw to copy from.
+        \return This ImGuiDraw.
+    */
+    ImGuiDraw& operator=(const ImGuiDraw& rhs);
+    
+    virtual ~ImGuiDraw();
     virtual void DrawImGui(void) = 0;
 };
\ No newline at end of file
@@ -5,7 +5,7 @@
 */
 
 #include "Camera.h"
-#include "Shader.h"
+#include "FrameUniforms.h"
 #include "../Object.h"
 #include "../Graphics.h"
 
@@ -18,6 +18,9 @@
 #include <glm/gtc/type_ptr.hpp>
 //#include <glm/vec3.hpp>
 
+#include <cmath>
+#include <cstring>
+
 Camera::Camera() : look_at(0.0f, 0.0f, -1.0f), up(0.0f, 1.0f, 0.0f), right(1.0f, 0.0f, 0.0f)
 {
 }
@@ -27,41 +30,92 @@ Camera::~Camera()
   
 }
 
-void Camera::SetProjection(Shader* shader, const float& view_ratio)
+bool Camera::Update(float view_ratio)
 {
-  float fov = 90.f * (1.0f / zoom);
-  glm::mat4 proj = glm::perspective(fov, view_ratio, near_plane, far_plane);
-  shader->Use();
-  glUniformMatrix4fv(glGetUniformLocation(shader->program, "projection"), 1, GL_FALSE, glm::value_ptr(proj));
+  float inputs[INPUTS_];
+  Inputs_(inputs, view_ratio);
+  if (computed_ && !memcmp(inputs, inputs_, sizeof(inputs_)))
+    return false;
+  memcpy(inputs_, inputs, sizeof(inputs_));
+  computed_ = true;
+  ++version_;
+  
+  glm::mat4 proj = glm::perspective(FovRadians(), view_ratio, near_plane, far_plane);
   
   glm::vec3 position_vec3(position.x, position.y, position.z);
   glm::vec3 target_vec3(position_vec3 + glm::vec3(look_at.x, look_at.y, look_at.z));
   glm::vec3 up_vec3(up.x, up.y, up.z);
   glm::mat4 view = glm::lookAt(position_vec3, target_vec3, up_vec3);
-  shader->Use();
-  glUniformMatrix4fv(glGetUniformLocation(shader->program, "view"), 1, GL_FALSE, glm::value_ptr(view));
+  
+  memcpy(view_, glm::value_ptr(view), sizeof(view_));
+  memcpy(projection_, glm::value_ptr(proj), sizeof(projection_));
+  memcpy(view_projection_, glm::value_ptr(proj * view), sizeof(view_projection_));
+  frustum_.FromMatrix(view_projection_);
+  return true;
 }
 
-void Camera::SetBillboard(Shader* shader)
+void Camera::SetProjection(FrameUniforms& uniforms) const
 {
-  glUniform3f(glGetUniformLocation(shader->program, "cam_up"), up.x, up.y, up.z);
-  glUniform3f(glGetUniformLocation(shader->program, "cam_right"), right.x, right.y, right.z);
+  memcpy(uniforms.view, view_, sizeof(uniforms.view));
+  memcpy(uniforms.projection, projection_, sizeof(uniforms.projection));
+  memcpy(uniforms.view_projection, view_projection_, sizeof(uniforms.view_projection));
+  
+  // billboards face the camera using these
+  uniforms.cam_up[0] = up.x;
+  uniforms.cam_up[1] = up.y;
+  uniforms.cam_up[2] = up.z;
+  uniforms.cam_up[3] = 0.0f;
+  uniforms.cam_right[0] = right.x;
+  uniforms.cam_right[1] = right.y;
+  uniforms.cam_right[2] = right.z;
+  uniforms.cam_right[3] = 0.0f;
+}
+
+void Camera::ScreenRay(float x, float y, float* origin, float* direction) const
+{
+  glm::mat4 inverse = glm::inverse(glm::make_mat4(view_projection_));
+  glm::vec4 near_point = inverse * glm::vec4(x, y, -1.0f, 1.0f);
+  glm::vec4 far_point = inverse * glm::vec4(x, y, 1.0f, 1.0f);
+  glm::vec3 start = glm::vec3(near_point) / near_point.w;
+  glm::vec3 along = glm::normalize(glm::vec3(far_point) / far_point.w - start);
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    origin[axis] = start[axis];
+    direction[axis] = along[axis];
+  }
 }
 
 void Camera::SetFromObject(Object* obj)
 {
-  // set base values
-  up(0.0f, 1.0f, 0.0f);
-  look_at(0.0f, 0.0f, -1.0f);
+  // the model matrix columns are the rotated axes, up is +y and forward is -z
+  const float* model = obj->Model();
+  up(model[4], model[5], model[6]);
+  look_at(-model[8], -model[9], -model[10]);
+  // scale stretches the columns
+  up.Normalize();
+  look_at.Normalize();
   
-  // rotate based on object
-  up.RotateEulerRad(obj->rotation);
-  look_at.RotateEulerRad(obj->rotation);
-  
-  position = obj->position;
+  position(model[12], model[13], model[14]);
   right = up.Cross(look_at);
 }
 
+float Camera::FovRadians() const
+{
+  return glm::radians(90.f * (1.0f / zoom));
+}
+
+float Camera::ProjectionScale(float viewport_height) const
+{
+  return viewport_height / (2.0f * tanf(0.5f * FovRadians()));
+}
+
+void Camera::Inputs_(float* inputs, float view_ratio) const
+{
+  const float values[INPUTS_] = {position.x, position.y, position.z, look_at.x, look_at.y, look_at.z,
+                                 up.x, up.y, up.z, zoom, near_plane, far_plane, view_ratio};
+  memcpy(inputs, values, sizeof(values));
+}
+
 void Camera::Zoom(float zoom_)
 {
   if(zoom_ > 0.0f)
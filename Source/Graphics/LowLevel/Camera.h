@@ -7,9 +7,10 @@
 #pragma once
 
 #include "../../Math/Vector.h"
+#include "../../Math/Frustum.h"
 
 // forwards declarations so we need not include the files
-struct Shader;
+struct FrameUniforms;
 class Object;
 
 //! A component that manages data used in screen generation for 2D.
@@ -21,22 +22,52 @@ struct Camera
     //! \brief Calls Stop.
     ~Camera();
    
-    /*! \brief Sets the projection and view uniforms for 3D perspective projection.
-        \param shader The shader to set uniforms for.
+    /*! \brief Recomputes the matrices and frustum if position, look_at, up, zoom,
+               near_plane, far_plane, or the ratio changed since the last call.
+               Call once per frame before using them.
         \param view_ratio The width/height ratio of the Viewport being rendered to.
+        \return True if they were recomputed.
     */
-    void SetProjection(Shader* shader, const float& view_ratio);
+    bool Update(float view_ratio);
     
-    /*! \brief Sets cam_up and cam_right uniforms for billboarding in 3D.
-        \param shader The shader to set uniforms for.
+    /*! \brief Sets the view, projection, and billboarding values of the Frame uniforms from the cached matrices.
+        \param uniforms The uniforms to fill, uploaded by FrameUniformBuffer.
     */
-    void SetBillboard(Shader* shader);
+    void SetProjection(FrameUniforms& uniforms) const;
+    
+    //! \return The column major view matrix as of the last Update, 16 floats.
+    const float* View() const { return view_; }
+    //! \return The column major projection matrix as of the last Update, 16 floats.
+    const float* Projection() const { return projection_; }
+    //! \return The column major projection * view matrix as of the last Update, 16 floats.
+    const float* ViewProjection() const { return view_projection_; }
+    /*! \brief Computes the world space ray through a point of the screen, as of the last Update.
+        \param x The horizontal position from -1 at the left edge to 1 at the right.
+        \param y The vertical position from -1 at the bottom edge to 1 at the top.
+        \param origin Receives the point on the near plane.
+        \param direction Receives the unit direction toward the far plane.
+    */
+    void ScreenRay(float x, float y, float* origin, float* direction) const;
+    
+    //! \return The world space frustum as of the last Update.
+    const Frustum& GetFrustum() const { return frustum_; }
+    //! \return A count of recomputations, compare with a stored value to tell if the matrices changed.
+    unsigned Version() const { return version_; }
     
     /*! \brief Sets the variables for 3D based on an Object's variables
-        \param obj The object to base data on.
+        \param obj The object to base data on, read from its model matrix as of the last TransformHierarchy::Update.
     */
     void SetFromObject(Object* obj);
     
+    //! \return The vertical field of view in radians, from zoom.
+    float FovRadians() const;
+    
+    /*! \brief Returns the size in pixels of one unit at a distance of one unit, for sizing things on screen.
+        \param viewport_height The height in pixels of the Viewport being rendered to.
+        \return Pixels per unit, divide by the view distance to get the size at that distance.
+    */
+    float ProjectionScale(float viewport_height) const;
+    
     /*!
       \brief Multiplies zoom_ by the given amount.
       \param zoom The multiplier for zoom_, must be greater than 0.
@@ -53,9 +84,25 @@ struct Camera
     Vector right;
     
     //! Near plane of the camera, the closest point to the camera that will be rendered.
-    float near_plane = -10.f;
+    float near_plane = 0.1f;
     //! Far plane of the camera, the farthest point from the camera that will be rendered.
     float far_plane = 100.f;
     //! Zoom level of camera, in 3D acts as fov of (90 * 1/zoom).
     float zoom = 1.f;
+  
+  private:
+    //! Number of floats Inputs_ fills.
+    static const unsigned INPUTS_ = 13;
+    
+    //! \brief Copies everything the matrices depend on into inputs.
+    void Inputs_(float* inputs, float view_ratio) const;
+  
+    float view_[16];
+    float projection_[16];
+    float view_projection_[16];
+    Frustum frustum_;
+    //! What the matrices were computed from, compared instead of marking changes so the members stay public.
+    float inputs_[INPUTS_];
+    unsigned version_ = 0;
+    bool computed_ = false;
 };
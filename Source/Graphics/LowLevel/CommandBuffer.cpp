@@ -0,0 +1,141 @@
+/*! \file CommandBuffer.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of CommandBuffer class.
+*/
+
+#include "GL/glew.h"
+#include "CommandBuffer.h"
+#include "GLState.h"
+#include "Mesh.h"
+
+const unsigned CommandBuffer::OPERANDS[OP_COUNT] = { 1, 2, 2, 1, 1, 1, 3 };
+const char* const CommandBuffer::OP_NAMES[OP_COUNT] = { "UseProgram", "BindUniformBlock", "BindTexture", "BindVertexArray", "DepthMask", "InstanceAttributes", "DrawInstanced" };
+
+CommandBuffer::CommandBuffer()
+{
+  Clear();
+}
+
+void CommandBuffer::UseProgram(GLuint program)
+{
+  Begin_(UseProgramOp);
+  words_.push_back(program);
+}
+
+void CommandBuffer::BindUniformBlock(unsigned binding, GLuint buffer)
+{
+  Begin_(BindUniformBlockOp);
+  words_.push_back(binding);
+  words_.push_back(buffer);
+}
+
+void CommandBuffer::BindTexture(unsigned unit, GLuint texture)
+{
+  Begin_(BindTextureOp);
+  words_.push_back(unit);
+  words_.push_back(texture);
+}
+
+void CommandBuffer::BindVertexArray(GLuint vao)
+{
+  Begin_(BindVertexArrayOp);
+  words_.push_back(vao);
+}
+
+void CommandBuffer::DepthMask(bool write)
+{
+  Begin_(DepthMaskOp);
+  words_.push_back(write ? 1u : 0u);
+}
+
+void CommandBuffer::InstanceAttributes(unsigned offset)
+{
+  Begin_(InstanceAttributesOp);
+  words_.push_back(offset);
+}
+
+void CommandBuffer::DrawInstanced(unsigned index_count, unsigned index_offset, unsigned instance_count)
+{
+  Begin_(DrawInstancedOp);
+  words_.push_back(index_count);
+  words_.push_back(index_offset);
+  words_.push_back(instance_count);
+}
+
+void CommandBuffer::Clear()
+{
+  words_.clear();
+  count_ = 0;
+  for (unsigned op = 0; op < OP_COUNT; ++op)
+    op_counts_[op] = 0;
+}
+
+void CommandBuffer::Replay() const
+{
+  const GLsizei stride = Mesh::INSTANCE_FLOATS * sizeof(float);
+  const unsigned* word = words_.data();
+  const unsigned* end = word + words_.size();
+  while (word < end)
+  {
+    switch (*word++)
+    {
+      case UseProgramOp:
+        GL_STATE.UseProgram(word[0]);
+        word += 1;
+        break;
+      case BindUniformBlockOp:
+        glBindBufferBase(GL_UNIFORM_BUFFER, word[0], word[1]);
+        word += 2;
+        break;
+      case BindTextureOp:
+        GL_STATE.BindTexture(word[0], word[1]);
+        word += 2;
+        break;
+      case BindVertexArrayOp:
+        GL_STATE.BindVertexArray(word[0]);
+        word += 1;
+        break;
+      case DepthMaskOp:
+        GL_STATE.DepthMask(word[0] != 0);
+        word += 1;
+        break;
+      case InstanceAttributesOp:
+      {
+        // GL 3.3 has no base instance, so the columns are pointed at this group's matrices instead
+        size_t offset = word[0];
+        for (unsigned column = 0; column < 4; ++column)
+          glVertexAttribPointer(Mesh::INSTANCE_LOCATION + column, 4, GL_FLOAT, GL_FALSE, stride, (void*)(offset + column * 4 * sizeof(float)));
+        glVertexAttribPointer(Mesh::OPACITY_LOCATION, 1, GL_FLOAT, GL_FALSE, stride, (void*)(offset + 16 * sizeof(float)));
+        word += 1;
+        break;
+      }
+      case DrawInstancedOp:
+        glDrawElementsInstanced(GL_TRIANGLES, word[0], GL_UNSIGNED_INT, (void*)(size_t(word[1]) * sizeof(unsigned)), word[2]);
+        word += 3;
+        break;
+    }
+  }
+}
+
+void CommandBuffer::Dump(std::ostream& out) const
+{
+  const unsigned* word = words_.data();
+  const unsigned* end = word + words_.size();
+  while (word < end)
+  {
+    unsigned op = *word++;
+    out << OP_NAMES[op];
+    for (unsigned i = 0; i < OPERANDS[op]; ++i)
+      out << ' ' << word[i];
+    out << '\n';
+    word += OPERANDS[op];
+  }
+}
+
+void CommandBuffer::Begin_(Op op)
+{
+  words_.push_back(op);
+  ++count_;
+  ++op_counts_[op];
+}
@@ -0,0 +1,101 @@
+/*! \file CommandBuffer.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains CommandBuffer class, GL calls recorded as words on any thread and replayed on the GL thread.
+*/
+
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+typedef unsigned int	GLuint;
+
+/*! A list of GL calls packed as 32-bit words, an opcode followed by its
+    fixed number of arguments.
+
+    Recording makes no GL calls, so workers can each record part of a frame
+    into their own buffer. Replay decodes the words in order on the thread
+    owning the context, going through GL_STATE so redundant binds between
+    buffers are still skipped.
+*/
+class CommandBuffer
+{
+  public:
+    //! The commands, each followed by OPERANDS[op] words.
+    enum Op : unsigned
+    {
+      UseProgramOp,
+      BindUniformBlockOp,
+      BindTextureOp,
+      BindVertexArrayOp,
+      DepthMaskOp,
+      InstanceAttributesOp,
+      DrawInstancedOp,
+      OP_COUNT
+    };
+
+    //! Argument words of each Op.
+    static const unsigned OPERANDS[OP_COUNT];
+    //! Names of each Op, for Dump.
+    static const char* const OP_NAMES[OP_COUNT];
+
+    CommandBuffer();
+
+    //! \brief Records glUseProgram.
+    void UseProgram(GLuint program);
+
+    /*! \brief Records binding a uniform buffer to a block binding point.
+        \param binding The binding point, such as FRAME_UNIFORM_BINDING.
+        \param buffer The uniform buffer.
+    */
+    void BindUniformBlock(unsigned binding, GLuint buffer);
+
+    //! \brief Records binding a 2D texture to a texture unit, 0 for GL_TEXTURE0.
+    void BindTexture(unsigned unit, GLuint texture);
+
+    //! \brief Records glBindVertexArray.
+    void BindVertexArray(GLuint vao);
+
+    //! \brief Records glDepthMask.
+    void DepthMask(bool write);
+
+    /*! \brief Records pointing the per-instance attributes of the bound vertex array
+               into the array buffer bound at replay, see Mesh::INSTANCE_FLOATS.
+        \param offset Byte offset of the first instance.
+    */
+    void InstanceAttributes(unsigned offset);
+
+    /*! \brief Records glDrawElementsInstanced of unsigned int triangles.
+        \param index_count Indices per instance.
+        \param index_offset The first index.
+        \param instance_count The number of instances.
+    */
+    void DrawInstanced(unsigned index_count, unsigned index_offset, unsigned instance_count);
+
+    //! \brief Removes every command, keeping the storage.
+    void Clear();
+
+    //! \brief Issues every command in order, must be called on the GL thread.
+    void Replay() const;
+
+    /*! \brief Writes one line per command.
+        \param out The stream to write to.
+    */
+    void Dump(std::ostream& out) const;
+
+    //! \return The number of commands recorded.
+    unsigned Count() const { return count_; }
+    //! \return The number of commands of one kind recorded.
+    unsigned Count(Op op) const { return op_counts_[op]; }
+    //! \return The size of the recorded commands.
+    size_t Bytes() const { return words_.size() * sizeof(unsigned); }
+
+  private:
+    //! \brief Appends an opcode and counts it, the caller appends its operands.
+    void Begin_(Op op);
+
+    std::vector<unsigned> words_;
+    unsigned count_;
+    unsigned op_counts_[OP_COUNT];
+};
@@ -0,0 +1,56 @@
+/*! \file FrameUniforms.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of FrameUniformBuffer.
+*/
+
+#include "FrameUniforms.h"
+#include "Camera.h"
+#include "Viewport.h"
+#include "GLState.h"
+
+#include "GL/glew.h"
+
+FrameUniformBuffer::FrameUniformBuffer() : buffer_(0), values_()
+{
+}
+
+void FrameUniformBuffer::Initialize()
+{
+  glGenBuffers(1, &buffer_);
+  GL_STATE.BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+  // the indexed binding is never changed again, only the contents
+  glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, buffer_);
+}
+
+void FrameUniformBuffer::Exit()
+{
+  if (buffer_)
+    GL_STATE.DeleteBuffer(buffer_);
+  buffer_ = 0;
+}
+
+void FrameUniformBuffer::Compute(FrameUniforms& values, const Camera& camera, const Viewport& viewport, float time)
+{
+  camera.SetProjection(values);
+  values.viewport_size[0] = float(viewport.size[0]);
+  values.viewport_size[1] = float(viewport.size[1]);
+  values.time = time;
+}
+
+void FrameUniformBuffer::Upload(const FrameUniforms& values)
+{
+  values_ = values;
+  GL_STATE.BindBuffer(GL_UNIFORM_BUFFER, buffer_);
+  // orphan the storage so updating for another Viewport need not wait for draws of the last
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &values_);
+}
+
+void FrameUniformBuffer::BindBlock(GLuint program)
+{
+  GLuint index = glGetUniformBlockIndex(program, FRAME_UNIFORM_BLOCK);
+  if (index != GL_INVALID_INDEX)
+    glUniformBlockBinding(program, index, FRAME_UNIFORM_BINDING);
+}
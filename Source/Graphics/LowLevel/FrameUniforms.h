@@ -0,0 +1,89 @@
+/*! \file FrameUniforms.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains FrameUniforms, the per-frame shader constants, and FrameUniformBuffer, the uniform buffer holding them.
+*/
+
+#pragma once
+
+typedef unsigned int	GLuint;
+struct Camera;
+struct Viewport;
+
+//! Uniform buffer binding point of the Frame block, shared by every shader.
+const unsigned FRAME_UNIFORM_BINDING = 0;
+//! Name of the block as declared in shaders.
+#define FRAME_UNIFORM_BLOCK "Frame"
+
+/*! The Frame uniform block, laid out to match std140:
+
+    layout(std140) uniform Frame
+    {
+      mat4 view;
+      mat4 projection;
+      mat4 view_projection;
+      vec3 cam_up;
+      vec3 cam_right;
+      vec2 viewport_size;
+      float time;
+    };
+*/
+struct FrameUniforms
+{
+  //! Column major matrices.
+  float view[16];
+  float projection[16];
+  float view_projection[16];
+  //! std140 aligns vec3 to 16 bytes, the fourth float is padding.
+  float cam_up[4];
+  float cam_right[4];
+  //! In pixels.
+  float viewport_size[2];
+  //! Seconds since Graphics was initialized.
+  float time;
+  float padding_;
+};
+
+static_assert(sizeof(FrameUniforms) == 240, "FrameUniforms must match the std140 layout of the Frame block");
+
+/*! Holds FrameUniforms in one uniform buffer bound to FRAME_UNIFORM_BINDING,
+    so each shader reads the camera from the buffer instead of having it
+    uploaded into every program. Shader::Compile links any Frame block to
+    the binding, so new shaders cost nothing extra per frame.
+*/
+class FrameUniformBuffer
+{
+  public:
+    FrameUniformBuffer();
+    
+    //! \brief Creates the buffer and binds it to FRAME_UNIFORM_BINDING.
+    void Initialize();
+    
+    //! \brief Deletes the buffer.
+    void Exit();
+    
+    /*! \brief Fills the uniforms of a frame, makes no GL calls so any thread may call it.
+        \param values Receives the uniforms.
+        \param camera The camera viewing through the Viewport, updated for its ratio.
+        \param viewport The Viewport being drawn, its size is used.
+        \param time Seconds since Graphics was initialized.
+    */
+    static void Compute(FrameUniforms& values, const Camera& camera, const Viewport& viewport, float time);
+    
+    /*! \brief Uploads the uniforms, call once per frame and Viewport before drawing it.
+        \param values The uniforms from Compute, copied.
+    */
+    void Upload(const FrameUniforms& values);
+    
+    /*! \brief Links a program's Frame block, if it has one, to FRAME_UNIFORM_BINDING.
+        \param program A linked program.
+    */
+    static void BindBlock(GLuint program);
+    
+    //! \return The values last uploaded.
+    const FrameUniforms& Values() const { return values_; }
+  
+  private:
+    GLuint buffer_;
+    FrameUniforms values_;
+};
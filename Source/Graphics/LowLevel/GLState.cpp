@@ -0,0 +1,189 @@
+/*! \file GLState.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of GLState class.
+*/
+
+#include "GL/glew.h"
+#include "GLState.h"
+
+GLState GL_STATE;
+
+GLState::GLState()
+{
+  Invalidate();
+}
+
+void GLState::Invalidate()
+{
+  program_ = UNKNOWN_;
+  active_unit_ = UNKNOWN_;
+  for (unsigned i = 0; i < MAX_TEXTURE_UNITS; ++i)
+    textures_[i] = UNKNOWN_;
+  vao_ = UNKNOWN_;
+  for (unsigned i = 0; i < BUFFER_TARGETS_; ++i)
+    buffers_[i] = UNKNOWN_;
+  for (unsigned i = 0; i < CAPABILITIES_; ++i)
+    capabilities_[i] = UNKNOWN_;
+  blend_source_ = blend_destination_ = UNKNOWN_;
+  depth_mask_ = UNKNOWN_;
+  viewport_known_ = false;
+}
+
+void GLState::EndFrame()
+{
+  last_frame_ = frame_;
+  frame_ = Counters();
+}
+
+void GLState::UseProgram(GLuint program)
+{
+  if (!Issue_(program_ == program))
+    return;
+  program_ = program;
+  glUseProgram(program);
+}
+
+void GLState::BindTexture(unsigned unit, GLuint texture)
+{
+  bool cached = unit < MAX_TEXTURE_UNITS;
+  if (!Issue_(cached && textures_[unit] == texture))
+    return;
+  
+  if (Issue_(active_unit_ == unit))
+  {
+    active_unit_ = unit;
+    glActiveTexture(GL_TEXTURE0 + unit);
+  }
+  if (cached)
+    textures_[unit] = texture;
+  glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLState::BindVertexArray(GLuint vao)
+{
+  if (!Issue_(vao_ == vao))
+    return;
+  vao_ = vao;
+  // the element array binding is part of the vertex array
+  buffers_[BufferIndex_(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN_;
+  glBindVertexArray(vao);
+}
+
+void GLState::BindBuffer(GLenum target, GLuint buffer)
+{
+  unsigned index = BufferIndex_(target);
+  if (!Issue_(index < BUFFER_TARGETS_ && buffers_[index] == buffer))
+    return;
+  if (index < BUFFER_TARGETS_)
+    buffers_[index] = buffer;
+  glBindBuffer(target, buffer);
+}
+
+void GLState::SetEnabled(GLenum capability, bool enabled)
+{
+  unsigned index = CapabilityIndex_(capability);
+  if (!Issue_(index < CAPABILITIES_ && capabilities_[index] == GLuint(enabled)))
+    return;
+  if (index < CAPABILITIES_)
+    capabilities_[index] = enabled;
+  if (enabled)
+    glEnable(capability);
+  else
+    glDisable(capability);
+}
+
+void GLState::BlendFunc(GLenum source, GLenum destination)
+{
+  if (!Issue_(blend_source_ == source && blend_destination_ == destination))
+    return;
+  blend_source_ = source;
+  blend_destination_ = destination;
+  glBlendFunc(source, destination);
+}
+
+void GLState::DepthMask(bool write)
+{
+  if (!Issue_(depth_mask_ == GLuint(write)))
+    return;
+  depth_mask_ = write;
+  glDepthMask(write ? GL_TRUE : GL_FALSE);
+}
+
+void GLState::Viewport(int x, int y, int width, int height)
+{
+  if (!Issue_(viewport_known_ && viewport_[0] == x && viewport_[1] == y && viewport_[2] == width && viewport_[3] == height))
+    return;
+  viewport_[0] = x;
+  viewport_[1] = y;
+  viewport_[2] = width;
+  viewport_[3] = height;
+  viewport_known_ = true;
+  glViewport(x, y, width, height);
+}
+
+void GLState::DeleteProgram(GLuint program)
+{
+  // a program in use is only flagged for deletion, forget it so the next use is issued
+  if (program_ == program)
+    program_ = UNKNOWN_;
+  glDeleteProgram(program);
+}
+
+void GLState::DeleteTexture(GLuint texture)
+{
+  for (unsigned i = 0; i < MAX_TEXTURE_UNITS; ++i)
+    if (textures_[i] == texture)
+      textures_[i] = 0;
+  glDeleteTextures(1, &texture);
+}
+
+void GLState::DeleteVertexArray(GLuint vao)
+{
+  if (vao_ == vao)
+  {
+    vao_ = 0;
+    buffers_[BufferIndex_(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN_;
+  }
+  glDeleteVertexArrays(1, &vao);
+}
+
+void GLState::DeleteBuffer(GLuint buffer)
+{
+  for (unsigned i = 0; i < BUFFER_TARGETS_; ++i)
+    if (buffers_[i] == buffer)
+      buffers_[i] = 0;
+  glDeleteBuffers(1, &buffer);
+}
+
+unsigned GLState::BufferIndex_(GLenum target)
+{
+  switch (target)
+  {
+    case GL_ARRAY_BUFFER: return 0;
+    case GL_ELEMENT_ARRAY_BUFFER: return 1;
+    case GL_UNIFORM_BUFFER: return 2;
+    default: return BUFFER_TARGETS_;
+  }
+}
+
+unsigned GLState::CapabilityIndex_(GLenum capability)
+{
+  switch (capability)
+  {
+    case GL_BLEND: return 0;
+    case GL_DEPTH_TEST: return 1;
+    case GL_CULL_FACE: return 2;
+    case GL_SCISSOR_TEST: return 3;
+    default: return CAPABILITIES_;
+  }
+}
+
+bool GLState::Issue_(bool redundant)
+{
+  if (redundant)
+    ++frame_.skipped;
+  else
+    ++frame_.issued;
+  return !redundant;
+}
@@ -0,0 +1,128 @@
+/*! \file GLState.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains GLState class, a cache of bound GL objects and fixed function state that skips redundant calls.
+*/
+
+#pragma once
+
+typedef unsigned int	GLuint;
+typedef unsigned int	GLenum;
+
+/*! Mirrors the GL state this program changes, so setting a value that is
+    already set costs a compare instead of a driver call.
+
+    Every change to cached state must go through GL_STATE, and Invalidate
+    must be called after code that bypasses it, such as the ImGui renderer.
+    Deleting objects through GL_STATE keeps the cache from holding names GL
+    has unbound and may hand out again.
+*/
+class GLState
+{
+  public:
+    //! Texture units tracked, binds to higher units are always issued.
+    static const unsigned MAX_TEXTURE_UNITS = 16;
+    
+    //! GL calls issued and skipped.
+    struct Counters
+    {
+      unsigned issued = 0;
+      unsigned skipped = 0;
+    };
+  
+    //! \brief Starts with every value unknown, no GL calls are made.
+    GLState();
+    
+    //! \brief Forgets every cached value, so the next call of each kind is issued.
+    void Invalidate();
+    
+    /*! \brief Moves this frame's counters to the last frame's and clears them.
+        Call once per frame.
+    */
+    void EndFrame();
+    
+    //! \return The counters of the last full frame.
+    const Counters& LastFrame() const { return last_frame_; }
+  
+    //! \brief Calls glUseProgram if program is not in use.
+    void UseProgram(GLuint program);
+    
+    /*! \brief Binds a 2D texture to a texture unit, calling glActiveTexture only if needed.
+        \param unit The texture unit, 0 for GL_TEXTURE0.
+        \param texture The texture name.
+    */
+    void BindTexture(unsigned unit, GLuint texture);
+    
+    //! \brief Calls glBindVertexArray if vao is not bound.
+    void BindVertexArray(GLuint vao);
+    
+    /*! \brief Calls glBindBuffer if buffer is not bound to target.
+        The element array binding belongs to the vertex array and is cached per BindVertexArray.
+        \param target GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, or GL_UNIFORM_BUFFER, others are always issued.
+        \param buffer The buffer name.
+    */
+    void BindBuffer(GLenum target, GLuint buffer);
+    
+    /*! \brief Calls glEnable or glDisable if the capability is not already in that state.
+        \param capability GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, or GL_SCISSOR_TEST, others are always issued.
+        \param enabled True to enable.
+    */
+    void SetEnabled(GLenum capability, bool enabled);
+    
+    //! \brief Calls glBlendFunc if the factors differ.
+    void BlendFunc(GLenum source, GLenum destination);
+    
+    //! \brief Calls glDepthMask if depth writes are not already in that state.
+    void DepthMask(bool write);
+    
+    //! \brief Calls glViewport if the rectangle differs.
+    void Viewport(int x, int y, int width, int height);
+    
+    //! \brief Deletes a program, forgetting it if in use.
+    void DeleteProgram(GLuint program);
+    //! \brief Deletes a texture, forgetting it in every unit.
+    void DeleteTexture(GLuint texture);
+    //! \brief Deletes a vertex array, forgetting it if bound.
+    void DeleteVertexArray(GLuint vao);
+    //! \brief Deletes a buffer, forgetting it in every target.
+    void DeleteBuffer(GLuint buffer);
+  
+  private:
+    //! Buffer targets cached, in the order of BufferIndex_.
+    static const unsigned BUFFER_TARGETS_ = 3;
+    //! Capabilities cached, in the order of CapabilityIndex_.
+    static const unsigned CAPABILITIES_ = 4;
+    //! Marks a value as unknown, GL never hands out this name.
+    static const GLuint UNKNOWN_ = ~0u;
+    
+    //! \return The cache slot of a buffer target, or BUFFER_TARGETS_ if not cached.
+    static unsigned BufferIndex_(GLenum target);
+    //! \return The cache slot of a capability, or CAPABILITIES_ if not cached.
+    static unsigned CapabilityIndex_(GLenum capability);
+    
+    /*! \brief Counts a call as skipped or issued.
+        \param redundant True if the call would not change anything.
+        \return True if the call must be issued.
+    */
+    bool Issue_(bool redundant);
+  
+    GLuint program_;
+    unsigned active_unit_;
+    GLuint textures_[MAX_TEXTURE_UNITS];
+    GLuint vao_;
+    GLuint buffers_[BUFFER_TARGETS_];
+    //! 0 disabled, 1 enabled, UNKNOWN_ unknown.
+    GLuint capabilities_[CAPABILITIES_];
+    GLenum blend_source_;
+    GLenum blend_destination_;
+    //! 0 off, 1 on, UNKNOWN_ unknown.
+    GLuint depth_mask_;
+    int viewport_[4];
+    bool viewport_known_;
+    
+    Counters frame_;
+    Counters last_frame_;
+};
+
+//! The state of the one GL context, only used on its thread.
+extern GLState GL_STATE;
@@ -0,0 +1,112 @@
+/*! \file Mesh.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of Mesh struct.
+*/
+
+#include "GL/glew.h"
+#include "Mesh.h"
+#include "GLState.h"
+#include "CommandBuffer.h"
+
+#include <cmath>
+#include <unordered_map>
+
+Mesh::Mesh(const char* name_) : name(name_), state(Loading), vao(0), vbo(0), ebo(0), vertex_count(0), index_count(0), bounds_radius(0.0f)
+{
+  bounds_min[0] = bounds_min[1] = bounds_min[2] = 0.0f;
+  bounds_max[0] = bounds_max[1] = bounds_max[2] = 0.0f;
+  bounds_center[0] = bounds_center[1] = bounds_center[2] = 0.0f;
+}
+
+void Mesh::Upload(const MeshView& data)
+{
+  vertex_count = data.vertex_count;
+  index_count = data.index_count;
+  float extent_sq = 0.0f;
+  for (unsigned axis = 0; axis < 3; ++axis)
+  {
+    bounds_min[axis] = data.bounds_min[axis];
+    bounds_max[axis] = data.bounds_max[axis];
+    bounds_center[axis] = 0.5f * (bounds_min[axis] + bounds_max[axis]);
+    extent_sq += (bounds_max[axis] - bounds_min[axis]) * (bounds_max[axis] - bounds_min[axis]);
+  }
+  bounds_radius = 0.5f * sqrtf(extent_sq);
+  
+  lods.assign(data.lods, data.lods + data.lod_count);
+  if (lods.empty())
+    lods.push_back(MeshLod{0, index_count, 0.0f});
+  
+  // copy the positions the occluder level uses, renumbered so unused vertices are left out
+  unsigned occluder_lod = 0;
+  while (occluder_lod + 1 < lods.size() && lods[occluder_lod + 1].error <= OCCLUDER_MAX_ERROR)
+    ++occluder_lod;
+  std::unordered_map<unsigned, unsigned> remap;
+  occluder_positions.clear();
+  occluder_indices.resize(lods[occluder_lod].index_count);
+  for (unsigned i = 0; i < lods[occluder_lod].index_count; ++i)
+  {
+    unsigned vertex = data.indices[lods[occluder_lod].index_offset + i];
+    auto found = remap.emplace(vertex, unsigned(remap.size()));
+    if (found.second)
+      occluder_positions.insert(occluder_positions.end(), data.vertices + size_t(vertex) * MeshData::VERTEX_FLOATS, data.vertices + size_t(vertex) * MeshData::VERTEX_FLOATS + 3);
+    occluder_indices[i] = found.first->second;
+  }
+  
+  glGenVertexArrays(1, &vao);
+  glGenBuffers(1, &vbo);
+  glGenBuffers(1, &ebo);
+  
+  GL_STATE.BindVertexArray(vao);
+  GL_STATE.BindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(vertex_count) * MeshData::VERTEX_FLOATS * sizeof(float), data.vertices, GL_STATIC_DRAW);
+  GL_STATE.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, GLsizeiptr(index_count) * sizeof(unsigned), data.indices, GL_STATIC_DRAW);
+  
+  // position, uv, normal at locations 0, 1, 2
+  const GLsizei stride = MeshData::VERTEX_FLOATS * sizeof(float);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(MeshData::UV_OFFSET * sizeof(float)));
+  glEnableVertexAttribArray(2);
+  glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)(MeshData::NORMAL_OFFSET * sizeof(float)));
+  
+  // model matrix columns and opacity advance once per instance, their buffer is set by Draw
+  for (unsigned location = INSTANCE_LOCATION; location <= OPACITY_LOCATION; ++location)
+  {
+    glEnableVertexAttribArray(location);
+    glVertexAttribDivisor(location, 1);
+  }
+  
+  GL_STATE.BindVertexArray(0);
+}
+
+void Mesh::Release()
+{
+  if (vao)
+  {
+    GL_STATE.DeleteVertexArray(vao);
+    GL_STATE.DeleteBuffer(vbo);
+    GL_STATE.DeleteBuffer(ebo);
+  }
+  vao = vbo = ebo = 0;
+}
+
+unsigned Mesh::SelectLod(float projected_radius) const
+{
+  // errors only grow with each level, so stop at the first one that is too coarse
+  unsigned lod = 0;
+  while (lod + 1 < lods.size() && lods[lod + 1].error * projected_radius <= LOD_ERROR_PIXELS)
+    ++lod;
+  return lod;
+}
+
+unsigned Mesh::Record(CommandBuffer& commands, unsigned lod, unsigned instance_count, size_t instance_offset) const
+{
+  const MeshLod& range = lods[lod];
+  commands.BindVertexArray(vao);
+  commands.InstanceAttributes(unsigned(instance_offset));
+  commands.DrawInstanced(range.index_count, range.index_offset, instance_count);
+  return range.index_count / 3;
+}
@@ -0,0 +1,104 @@
+/*! \file Mesh.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Declaration of Mesh struct, GPU buffers for one imported model.
+*/
+
+#pragma once
+
+#include "../Model/MeshData.h"
+
+#include <string>
+#include <vector>
+
+typedef unsigned int	GLuint;
+class CommandBuffer;
+
+//! Vertex array, vertex buffer, and index buffer of a model, owned by ModelLoader.
+struct Mesh
+{
+  //! Screen space error in pixels a level of detail may have to be chosen.
+  static constexpr float LOD_ERROR_PIXELS = 1.0f;
+  //! Attribute location of the first column of the per-instance model matrix, the others follow.
+  static const unsigned INSTANCE_LOCATION = 3;
+  //! Attribute location of the per-instance opacity.
+  static const unsigned OPACITY_LOCATION = INSTANCE_LOCATION + 4;
+  //! Floats of per-instance data: the model matrix, then opacity.
+  static const unsigned INSTANCE_FLOATS = 17;
+  //! Most error, relative to the bounding radius, the level of detail kept for occlusion culling may have.
+  static constexpr float OCCLUDER_MAX_ERROR = 0.01f;
+
+  //! Where the Mesh is in the import pipeline.
+  enum State
+  {
+    Loading, //!< Being parsed on a worker or waiting for upload, not drawable.
+    Ready,   //!< Uploaded and drawable.
+    Failed   //!< The file could not be imported, never drawable.
+  };
+
+  /*! \brief Constructs an empty Mesh in the Loading state, no GL calls are made.
+      \param name The file the Mesh is loaded from.
+  */
+  Mesh(const char* name);
+  
+  /*! \brief Creates the GL buffers from imported data, leaving the state for ModelLoader::Publish.
+      Must be called on the thread owning the GL context.
+      \param data The imported vertices and indices, read directly by the driver.
+  */
+  void Upload(const MeshView& data);
+  
+  //! \brief Deletes the GL buffers, must be called on the thread owning the GL context.
+  void Release();
+  
+  /*! \brief Picks the coarsest level of detail that stays within LOD_ERROR_PIXELS.
+      \param projected_radius The bounding sphere radius on screen in pixels.
+      \return The level of detail, 0 is full detail.
+  */
+  unsigned SelectLod(float projected_radius) const;
+  
+  /*! \brief Records binding the vertex array and drawing instances of a level of detail, makes no GL calls.
+      
+      The buffer of per-instance data must be bound to GL_ARRAY_BUFFER when replayed, see RenderQueue.
+      \param commands The buffer to record into.
+      \param lod The level of detail, must be less than the number of levels.
+      \param instance_count The number of instances to draw.
+      \param instance_offset Byte offset of the first instance's data in the bound buffer.
+      \return The number of triangles drawn per instance.
+  */
+  unsigned Record(CommandBuffer& commands, unsigned lod, unsigned instance_count, size_t instance_offset) const;
+  
+  //! \return True if the Mesh can be drawn.
+  bool IsReady() const { return state == Ready; }
+  
+  //! The file the Mesh is loaded from.
+  std::string name;
+  //! Where the Mesh is in the import pipeline.
+  State state;
+  
+  //! Vertex array object.
+  GLuint vao;
+  //! Interleaved vertex buffer.
+  GLuint vbo;
+  //! Index buffer.
+  GLuint ebo;
+  //! Number of vertices in vbo.
+  unsigned vertex_count;
+  //! Number of indices in ebo, over every level of detail.
+  unsigned index_count;
+  //! Index ranges of each level of detail, finest first.
+  std::vector<MeshLod> lods;
+  
+  //! Lower corner of the axis aligned bounds in model space.
+  float bounds_min[3];
+  //! Upper corner of the axis aligned bounds in model space.
+  float bounds_max[3];
+  //! Center of the bounding sphere in model space.
+  float bounds_center[3];
+  //! Radius of the bounding sphere in model space.
+  float bounds_radius;
+  
+  //! Positions of the coarsest level of detail within OCCLUDER_MAX_ERROR, 3 floats per vertex, kept on the CPU for OcclusionBuffer.
+  std::vector<float> occluder_positions;
+  //! Triangle list indices into occluder_positions.
+  std::vector<unsigned> occluder_indices;
+};
@@ -6,8 +6,11 @@
 
 #include "GL/glew.h"
 #include "Shader.h"
+#include "GLState.h"
+#include "FrameUniforms.h"
 #include "../..//Debug/DebugLog.h"
 
+#include <algorithm>
 #include <stdio.h>
 #include <sstream>
 #include <string>
@@ -85,6 +88,32 @@ static void PrintShaderResults(GLuint shader, const char* name, bool compile = t
   }
 }
 
+// true if a setter writing type may set a uniform declared as uniform_type, samplers are set with glUniform1i
+static bool TypeAccepts(GLenum type, GLenum uniform_type)
+{
+  if (type == uniform_type)
+    return true;
+  if (type != GL_INT)
+    return false;
+  switch (uniform_type)
+  {
+    case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_1D_SHADOW: case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_CUBE_SHADOW:
+    case GL_SAMPLER_1D_ARRAY: case GL_SAMPLER_2D_ARRAY: case GL_SAMPLER_1D_ARRAY_SHADOW: case GL_SAMPLER_2D_ARRAY_SHADOW:
+    case GL_SAMPLER_2D_MULTISAMPLE: case GL_SAMPLER_2D_MULTISAMPLE_ARRAY: case GL_SAMPLER_BUFFER:
+    case GL_SAMPLER_2D_RECT: case GL_SAMPLER_2D_RECT_SHADOW:
+    case GL_INT_SAMPLER_1D: case GL_INT_SAMPLER_2D: case GL_INT_SAMPLER_3D: case GL_INT_SAMPLER_CUBE:
+    case GL_INT_SAMPLER_1D_ARRAY: case GL_INT_SAMPLER_2D_ARRAY: case GL_INT_SAMPLER_2D_MULTISAMPLE:
+    case GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY: case GL_INT_SAMPLER_BUFFER: case GL_INT_SAMPLER_2D_RECT:
+    case GL_UNSIGNED_INT_SAMPLER_1D: case GL_UNSIGNED_INT_SAMPLER_2D: case GL_UNSIGNED_INT_SAMPLER_3D: case GL_UNSIGNED_INT_SAMPLER_CUBE:
+    case GL_UNSIGNED_INT_SAMPLER_1D_ARRAY: case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY: case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE:
+    case GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY: case GL_UNSIGNED_INT_SAMPLER_BUFFER: case GL_UNSIGNED_INT_SAMPLER_2D_RECT:
+      return true;
+    default:
+      return false;
+  }
+}
+
 // HELPER FUNCTIONS END
 Shader::Shader(void) : name("BadShader"), program(-1)
 {
@@ -96,7 +125,7 @@ Shader::Shader(const char* name_) : program(-1)
   Compile(name_);
 }
 
-Shader::Shader(const Shader& rhs) : name(rhs.name), program(rhs.program)
+Shader::Shader(const Shader& rhs) : name(rhs.name), program(rhs.program), uniforms(rhs.uniforms)
 {
 
 }
@@ -131,6 +160,11 @@ void Shader::Compile(const char* name_)
   
   glDeleteShader(vert);
   glDeleteShader(frag);
+  
+  FrameUniformBuffer::BindBlock(program);
+  Reflect_();
+  // linking resets samplers, shaders without one ignore this
+  SetInt(HashUniformName(DIFFUSE_TEXTURE_SAMPLER), int(DIFFUSE_TEXTURE_UNIT));
 }
 
 void Shader::Recompile()
@@ -151,5 +185,70 @@ void Shader::Recompile()
 
 void Shader::Use()
 {
-  glUseProgram(program);
+  GL_STATE.UseProgram(program);
+}
+
+const Shader::Uniform* Shader::FindUniform(unsigned hash) const
+{
+  auto found = std::lower_bound(uniforms.begin(), uniforms.end(), hash, [](const Uniform& uniform, unsigned value) { return uniform.hash < value; });
+  return found != uniforms.end() && found->hash == hash ? &*found : nullptr;
+}
+
+void Shader::SetInt(unsigned hash, int value)
+{
+  int location = Prepare_(hash, GL_INT);
+  if (location >= 0)
+    glUniform1i(location, value);
+}
+
+void Shader::Reflect_()
+{
+  uniforms.clear();
+  GLint linked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  if (linked != GL_TRUE)
+    return;
+  
+  GLint count = 0, max_length = 0;
+  glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+  std::string uniform_name(size_t(max_length > 0 ? max_length : 1), '\0');
+  
+  for (GLint i = 0; i < count; ++i)
+  {
+    GLsizei length = 0;
+    Uniform uniform;
+    glGetActiveUniform(program, GLuint(i), max_length, &length, &uniform.size, &uniform.type, &uniform_name[0]);
+    std::string key(uniform_name.c_str(), size_t(length));
+    uniform.location = glGetUniformLocation(program, key.c_str());
+    // uniforms in blocks have no location, they are set through buffers
+    if (uniform.location < 0)
+      continue;
+    
+    // arrays are reported as "name[0]", callers hash the plain name
+    size_t bracket = key.find('[');
+    if (bracket != std::string::npos)
+      key.resize(bracket);
+    uniform.hash = HashUniformName(key.c_str());
+    uniforms.push_back(uniform);
+  }
+  
+  std::sort(uniforms.begin(), uniforms.end(), [](const Uniform& a, const Uniform& b) { return a.hash < b.hash; });
+  for (size_t i = 1; i < uniforms.size(); ++i)
+    LOG_MARKED_IF(name << " has two uniforms with hash " << uniforms[i].hash << ", rename one", uniforms[i].hash == uniforms[i - 1].hash, '!');
+}
+
+int Shader::Prepare_(unsigned hash, GLenum type)
+{
+  const Uniform* uniform = FindUniform(hash);
+  if (!uniform)
+    return -1;
+  // GL would reject the call anyway, so a mismatch is skipped in every build and only logged in debug
+  if (!TypeAccepts(type, uniform->type))
+  {
+    LOG_MARKED(name << " uniform " << hash << " set with the wrong type", '!');
+    return -1;
+  }
+  Use();
+  return uniform->location;
 }
@@ -6,23 +6,82 @@
 
 #pragma once
 
+#include <vector>
+
 typedef unsigned int	GLuint;
+typedef unsigned int	GLenum;
+
+/*! \brief Hashes a uniform name with 32-bit FNV-1a, usable at compile time.
+    \param name The uniform name as written in the shader.
+    \return The hash Shader uses to find the uniform.
+*/
+constexpr unsigned HashUniformName(const char* name)
+{
+  unsigned hash = 2166136261u;
+  for (; *name; ++name)
+    hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+  return hash;
+}
+
+//! Texture unit RenderQueue binds each draw's texture to.
+const unsigned DIFFUSE_TEXTURE_UNIT = 0;
+//! Sampler shaders read that texture through, Compile points it at DIFFUSE_TEXTURE_UNIT.
+#define DIFFUSE_TEXTURE_SAMPLER "diffuse_texture"
 
 struct Shader
 {
+  //! An active uniform found when the program was linked.
+  struct Uniform
+  {
+    //! HashUniformName of the name, array uniforms without the "[0]".
+    unsigned hash;
+    int location;
+    //! The GL type, such as GL_FLOAT_MAT4.
+    GLenum type;
+    //! Number of array elements, 1 if not an array.
+    int size;
+  };
+
   Shader(void);
   Shader(const char*);
   Shader(const Shader&);
   
+  //! Compiles and links the program, then reflects its uniforms into uniforms.
   void Compile(const char* name);
   void Recompile();
   
-  //! Calls glUseProgram
+  //! Calls glUseProgram through GL_STATE, so it is skipped if already in use
   void Use();
+  
+  /*! \brief Finds an active uniform without touching GL.
+      \param hash HashUniformName of the name.
+      \return The uniform, or nullptr if the program has no such active uniform.
+  */
+  const Uniform* FindUniform(unsigned hash) const;
+  
+  /*! \brief Sets an int or sampler uniform, using the program, and does nothing if the uniform is not active.
+      \param hash HashUniformName of the name, computed once by the caller.
+      \param value The value, the texture unit for samplers.
+  */
+  void SetInt(unsigned hash, int value);
 
   // file data
   const char* name;
 
   // compiled program
   GLuint program;
+  
+  //! Active uniforms sorted by hash, refreshed by Compile and Recompile.
+  std::vector<Uniform> uniforms;
+  
+  private:
+    //! \brief Fills uniforms from the linked program.
+    void Reflect_();
+    
+    /*! \brief Uses the program and finds a uniform, checking the setter can write its type.
+        \param hash HashUniformName of the name.
+        \param type The type the setter writes, GL_INT also sets samplers.
+        \return The location, -1 if not active or of another type.
+    */
+    int Prepare_(unsigned hash, GLenum type);
 };
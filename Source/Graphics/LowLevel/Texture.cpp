@@ -5,6 +5,7 @@
 */
 
 #include "texture.h"
+#include "GLState.h"
 #include "../..//Debug/DebugLog.h"
 #include "STB/stb_image.h"
 #include <string>
@@ -28,7 +29,7 @@ Texture::Texture(const char* file) : ImGuiDraw(file), id(GLuint(-1)), width(GLui
 Texture::~Texture()
 {
   if(TexIsValid())
-    glDeleteTextures(1, &id);
+    GL_STATE.DeleteTexture(id);
 }
 
 void Texture::DrawImGui()
@@ -70,13 +71,13 @@ bool Texture::TexIsValid()
 
 void Texture::Bind() const
 {
-  glBindTexture(GL_TEXTURE_2D, id);
+  GL_STATE.BindTexture(0, id);
 }
 
 void Texture::Generate_(unsigned char* data)
 {
   // Create Texture
-  glBindTexture(GL_TEXTURE_2D, id);
+  GL_STATE.BindTexture(0, id);
   glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, image_format, GL_UNSIGNED_BYTE, data);
     
   // Set Texture wrap and filter modes
@@ -91,5 +92,5 @@ void Texture::Generate_(unsigned char* data)
   }
     
   // Unbind texture
-  glBindTexture(GL_TEXTURE_2D, 0);
+  GL_STATE.BindTexture(0, 0);
 }
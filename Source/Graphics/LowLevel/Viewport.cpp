@@ -7,6 +7,7 @@
 #include "Viewport.h"
 
 #include "GL/glew.h"
+#include "GLState.h"
 
 // initialize the static variables
 int Viewport::win_width = 0;
@@ -48,7 +49,7 @@ void Viewport::SetDimensions(int x0, int y0, int x1, int y1)
 
 void Viewport::Set() const
 {
-  glViewport(position[0], position[1], size[0], size[1]);
+  GL_STATE.Viewport(position[0], position[1], size[0], size[1]);
 }
 
 bool Viewport::IsInside(int x, int y) const
@@ -0,0 +1,203 @@
+/*! \file MeshCache.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of the binary mesh cache.
+*/
+
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ObjParser.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+const char* MESH_CACHE_FOLDER_PATH = "../Assets/Cache/";
+
+static const char MAGIC[4] = {'M', 'S', 'H', 'C'};
+
+// HELPER FUNCTIONS START
+
+static inline unsigned long long Rotate(unsigned long long value, unsigned bits)
+{
+  return (value << bits) | (value >> (64 - bits));
+}
+
+static inline unsigned long long Mix(unsigned long long lane, unsigned long long word)
+{
+  return Rotate(lane + word * 0xC2B2AE3D27D4EB4Full, 31) * 0x9E3779B97F4A7C15ull;
+}
+
+static unsigned long long AlignUp(unsigned long long value)
+{
+  return (value + MESH_CACHE_ALIGNMENT - 1) & ~(unsigned long long)(MESH_CACHE_ALIGNMENT - 1);
+}
+
+// the layout MeshData and Mesh::Upload agree on
+static void DescribeLayout(MeshCacheHeader& header)
+{
+  header.attribute_count = 3;
+  header.attributes[0] = VertexAttribute{VertexPosition, 3, 0};
+  header.attributes[1] = VertexAttribute{VertexUv, 2, MeshData::UV_OFFSET * sizeof(float)};
+  header.attributes[2] = VertexAttribute{VertexNormal, 3, MeshData::NORMAL_OFFSET * sizeof(float)};
+  header.attributes[3] = VertexAttribute{0, 0, 0};
+  header.vertex_stride = MeshData::VERTEX_FLOATS * sizeof(float);
+}
+
+static std::string CachePath(const char* cache_folder, unsigned long long path_hash)
+{
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.mesh", path_hash);
+  return std::string(cache_folder) + name;
+}
+
+// HELPER FUNCTIONS END
+
+unsigned long long HashBytes(const void* data, size_t size)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  // four independent lanes keep the multiplier busy
+  unsigned long long lanes[4] = {0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull, size};
+  
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32)
+    for (unsigned lane = 0; lane < 4; ++lane)
+    {
+      unsigned long long word;
+      memcpy(&word, bytes + i + lane * 8, 8);
+      lanes[lane] = Mix(lanes[lane], word);
+    }
+  
+  unsigned long long hash = Rotate(lanes[0], 1) + Rotate(lanes[1], 7) + Rotate(lanes[2], 12) + Rotate(lanes[3], 18);
+  for (; i < size; ++i)
+    hash = Mix(hash, bytes[i]);
+  
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+bool ReadMeshCache(const char* cache_path, unsigned long long path_hash, unsigned long long content_hash, MappedFile& file, MeshView& view)
+{
+  if (!file.Open(cache_path))
+    return false;
+  
+  MeshCacheHeader expected;
+  DescribeLayout(expected);
+  
+  const MeshCacheHeader* header = reinterpret_cast<const MeshCacheHeader*>(file.Data());
+  bool valid = file.Size() >= sizeof(MeshCacheHeader) &&
+               memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+               header->version == MESH_CACHE_VERSION &&
+               header->path_hash == path_hash &&
+               header->content_hash == content_hash &&
+               header->attribute_count == expected.attribute_count &&
+               memcmp(header->attributes, expected.attributes, sizeof(expected.attributes)) == 0 &&
+               header->vertex_stride == expected.vertex_stride &&
+               header->vertex_offset % MESH_CACHE_ALIGNMENT == 0 &&
+               header->index_offset % MESH_CACHE_ALIGNMENT == 0 &&
+               header->vertex_offset + (unsigned long long)(header->vertex_count) * header->vertex_stride <= file.Size() &&
+               header->index_offset + (unsigned long long)(header->index_count) * sizeof(unsigned) <= file.Size() &&
+               header->lod_count >= 1 && header->lod_count <= MeshData::MAX_LODS;
+  for (unsigned i = 0; valid && i < header->lod_count; ++i)
+    valid = (unsigned long long)(header->lods[i].index_offset) + header->lods[i].index_count <= header->index_count;
+  // the hash covers the source, not this file, so a damaged index would reach the GPU and the occlusion rasterizer
+  if (valid)
+  {
+    const unsigned* indices = reinterpret_cast<const unsigned*>(file.Data() + header->index_offset);
+    // a branchless maximum vectorizes, the file is valid far more often than not
+    unsigned largest = 0;
+    for (unsigned i = 0; i < header->index_count; ++i)
+      largest = indices[i] > largest ? indices[i] : largest;
+    valid = header->index_count == 0 || largest < header->vertex_count;
+  }
+  if (!valid)
+  {
+    file.Close();
+    return false;
+  }
+  
+  view.vertices = reinterpret_cast<const float*>(file.Data() + header->vertex_offset);
+  view.vertex_count = header->vertex_count;
+  view.indices = reinterpret_cast<const unsigned*>(file.Data() + header->index_offset);
+  view.index_count = header->index_count;
+  view.bounds_min = header->bounds_min;
+  view.bounds_max = header->bounds_max;
+  view.lods = header->lods;
+  view.lod_count = header->lod_count;
+  return true;
+}
+
+bool WriteMeshCache(const char* cache_path, unsigned long long path_hash, unsigned long long content_hash, const MeshData& data)
+{
+  MeshCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = MESH_CACHE_VERSION;
+  header.path_hash = path_hash;
+  header.content_hash = content_hash;
+  DescribeLayout(header);
+  header.vertex_count = data.VertexCount();
+  header.index_count = unsigned(data.indices.size());
+  memcpy(header.bounds_min, data.bounds_min, sizeof(header.bounds_min));
+  memcpy(header.bounds_max, data.bounds_max, sizeof(header.bounds_max));
+  header.lod_count = unsigned(data.lods.size() < MeshData::MAX_LODS ? data.lods.size() : MeshData::MAX_LODS);
+  memcpy(header.lods, data.lods.data(), header.lod_count * sizeof(MeshLod));
+  header.vertex_offset = AlignUp(sizeof(MeshCacheHeader));
+  header.index_offset = AlignUp(header.vertex_offset + data.vertices.size() * sizeof(float));
+  
+  // write beside the target and rename, so readers never map a partial file
+  std::string temp_path = std::string(cache_path) + ".tmp";
+  FILE* file = fopen(temp_path.c_str(), "wb");
+  if (!file)
+    return false;
+  
+  static const char PADDING[MESH_CACHE_ALIGNMENT] = {};
+  bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+  written = written && fwrite(PADDING, 1, size_t(header.vertex_offset - sizeof(header)), file) == size_t(header.vertex_offset - sizeof(header));
+  written = written && fwrite(data.vertices.data(), sizeof(float), data.vertices.size(), file) == data.vertices.size();
+  size_t padding = size_t(header.index_offset - header.vertex_offset - data.vertices.size() * sizeof(float));
+  written = written && fwrite(PADDING, 1, padding, file) == padding;
+  written = written && fwrite(data.indices.data(), sizeof(unsigned), data.indices.size(), file) == data.indices.size();
+  written = fclose(file) == 0 && written;
+  
+  std::error_code error;
+  if (written)
+    std::filesystem::rename(temp_path, cache_path, error);
+  if (!written || error)
+  {
+    std::filesystem::remove(temp_path, error);
+    return false;
+  }
+  return true;
+}
+
+bool ImportMesh(const char* path, ImportedMesh& mesh, ThreadPool* pool, const char* cache_folder)
+{
+  MappedFile source;
+  if (!source.Open(path))
+    return false;
+  
+  unsigned long long path_hash = HashBytes(path, strlen(path));
+  unsigned long long content_hash = HashBytes(source.Data(), source.Size());
+  std::string cache_path = CachePath(cache_folder, path_hash);
+  
+  mesh.from_cache = ReadMeshCache(cache_path.c_str(), path_hash, content_hash, mesh.cache, mesh.cache_view);
+  if (mesh.from_cache)
+    return mesh.cache_view.index_count != 0;
+  
+  if (!ParseObjText(source.Data(), source.Size(), mesh.data, pool))
+    return false;
+  // done once here, so cache hits get the levels of detail and optimized order for free
+  GenerateLods(mesh.data);
+  OptimizeMesh(mesh.data);
+  
+  // a failed write only costs the next run a parse
+  std::error_code error;
+  std::filesystem::create_directories(cache_folder, error);
+  WriteMeshCache(cache_path.c_str(), path_hash, content_hash, mesh.data);
+  return true;
+}
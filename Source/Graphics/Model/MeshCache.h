@@ -0,0 +1,123 @@
+/*! \file MeshCache.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains the binary mesh cache, which lets imports skip text parsing after the first run.
+*/
+
+#pragma once
+
+#include "MeshData.h"
+#include "../../Memory/MappedFile.h"
+
+class ThreadPool;
+
+//! Used to identify the mesh cache folder.
+extern const char* MESH_CACHE_FOLDER_PATH;
+
+//! Bumped whenever the layout or the import processing changes, older files are rebuilt.
+const unsigned MESH_CACHE_VERSION = 3;
+
+//! What a vertex attribute holds.
+enum VertexSemantic
+{
+  VertexPosition,
+  VertexUv,
+  VertexNormal
+};
+
+//! Describes one attribute of the interleaved vertex.
+struct VertexAttribute
+{
+  unsigned semantic;   //!< A VertexSemantic.
+  unsigned components; //!< Number of floats.
+  unsigned offset;     //!< Byte offset in the vertex.
+};
+
+/*! Start of every cache file. The vertex and index arrays follow at the
+    given offsets, each aligned to MESH_CACHE_ALIGNMENT, so a mapping of the
+    file can be handed to the driver as is.
+*/
+struct MeshCacheHeader
+{
+  static const unsigned MAX_ATTRIBUTES = 4;
+
+  char magic[4];
+  unsigned version;
+  //! Hash of the source path, guards against file name collisions.
+  unsigned long long path_hash;
+  //! Hash of the source file contents when the cache was written.
+  unsigned long long content_hash;
+  
+  unsigned attribute_count;
+  VertexAttribute attributes[MAX_ATTRIBUTES];
+  unsigned vertex_stride;
+  
+  unsigned vertex_count;
+  unsigned index_count;
+  float bounds_min[3];
+  float bounds_max[3];
+  
+  unsigned lod_count;
+  MeshLod lods[MeshData::MAX_LODS];
+  
+  unsigned long long vertex_offset;
+  unsigned long long index_offset;
+};
+
+//! Alignment of the arrays in a cache file.
+const unsigned MESH_CACHE_ALIGNMENT = 64;
+
+//! The result of ImportMesh, either parsed data or a mapping of the cache file.
+struct ImportedMesh
+{
+  //! \return The vertices and indices to upload, valid while this is alive.
+  MeshView View() const { return from_cache ? cache_view : data.View(); }
+  
+  //! Filled when the source was parsed.
+  MeshData data;
+  //! Open when the cache was used.
+  MappedFile cache;
+  //! Points into cache when it was used.
+  MeshView cache_view;
+  //! True if the cache was used.
+  bool from_cache = false;
+};
+
+/*! \brief Hashes bytes, fast enough to run over large model files on every load.
+    \param data The bytes to hash.
+    \param size The number of bytes.
+    \return A 64-bit hash.
+*/
+unsigned long long HashBytes(const void* data, size_t size);
+
+/*! \brief Maps a cache file and checks it matches the source.
+    \param cache_path The full path of the cache file.
+    \param path_hash The hash of the source path.
+    \param content_hash The hash of the source contents.
+    \param file Holds the mapping on success.
+    \param view Points into the mapping on success.
+    \return False if the file is missing, stale, from another version, or malformed.
+*/
+bool ReadMeshCache(const char* cache_path, unsigned long long path_hash, unsigned long long content_hash, MappedFile& file, MeshView& view);
+
+/*! \brief Writes a cache file, replacing any existing one once it is complete.
+    \param cache_path The full path of the cache file.
+    \param path_hash The hash of the source path.
+    \param content_hash The hash of the source contents.
+    \param data The mesh to store.
+    \return False if the file could not be written.
+*/
+bool WriteMeshCache(const char* cache_path, unsigned long long path_hash, unsigned long long content_hash, const MeshData& data);
+
+/*! \brief Loads a model through the cache, parsing and writing the cache on a miss.
+
+    The cache file name comes from the hash of path and the header holds the
+    hash of the contents, so edits to the source are picked up. Parsed
+    meshes go through GenerateLods and OptimizeMesh before they are cached.
+    \param path The full path of the OBJ file.
+    \param mesh Filled with the result.
+    \param pool Passed to the parser on a cache miss, may be nullptr.
+    \param cache_folder The folder cache files live in, created if missing.
+    \return False if the source could not be read or held no triangles.
+*/
+bool ImportMesh(const char* path, ImportedMesh& mesh, ThreadPool* pool = nullptr, const char* cache_folder = MESH_CACHE_FOLDER_PATH);
@@ -0,0 +1,42 @@
+/*! \file MeshData.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of MeshData.
+*/
+
+#include "MeshData.h"
+
+void MeshData::ComputeBounds()
+{
+  if (vertices.empty())
+  {
+    bounds_min[0] = bounds_min[1] = bounds_min[2] = 0.0f;
+    bounds_max[0] = bounds_max[1] = bounds_max[2] = 0.0f;
+    return;
+  }
+  
+  for (unsigned axis = 0; axis < 3; ++axis)
+    bounds_min[axis] = bounds_max[axis] = vertices[axis];
+  
+  for (size_t i = 0; i < vertices.size(); i += VERTEX_FLOATS)
+    for (unsigned axis = 0; axis < 3; ++axis)
+    {
+      float value = vertices[i + axis];
+      bounds_min[axis] = value < bounds_min[axis] ? value : bounds_min[axis];
+      bounds_max[axis] = value > bounds_max[axis] ? value : bounds_max[axis];
+    }
+}
+
+MeshView MeshData::View() const
+{
+  MeshView view;
+  view.vertices = vertices.data();
+  view.vertex_count = VertexCount();
+  view.indices = indices.data();
+  view.index_count = unsigned(indices.size());
+  view.bounds_min = bounds_min;
+  view.bounds_max = bounds_max;
+  view.lods = lods.data();
+  view.lod_count = unsigned(lods.size());
+  return view;
+}
@@ -0,0 +1,73 @@
+/*! \file MeshData.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains MeshData struct, CPU side vertex and index data ready for upload.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+//! A range of indices drawing a mesh at one level of detail.
+struct MeshLod
+{
+  //! First index of the range.
+  unsigned index_offset;
+  //! Number of indices in the range.
+  unsigned index_count;
+  //! Largest distance from the full detail surface, relative to the bounding sphere radius.
+  float error;
+};
+
+//! Read-only pointers to mesh data that may live in a MeshData or a mapped cache file.
+struct MeshView
+{
+  //! Interleaved vertex data, MeshData::VERTEX_FLOATS per vertex.
+  const float* vertices = nullptr;
+  unsigned vertex_count = 0;
+  //! Triangle list indices into vertices.
+  const unsigned* indices = nullptr;
+  unsigned index_count = 0;
+  //! Lower corner of the axis aligned bounds in model space.
+  const float* bounds_min = nullptr;
+  //! Upper corner of the axis aligned bounds in model space.
+  const float* bounds_max = nullptr;
+  //! Levels of detail, finest first, none if the whole index buffer is one level.
+  const MeshLod* lods = nullptr;
+  unsigned lod_count = 0;
+};
+
+//! Interleaved, indexed triangle data produced by the model importers.
+struct MeshData
+{
+  //! Floats per vertex: position xyz, uv, normal xyz.
+  static const unsigned VERTEX_FLOATS = 8;
+  //! Offset in floats of the uv in a vertex.
+  static const unsigned UV_OFFSET = 3;
+  //! Offset in floats of the normal in a vertex.
+  static const unsigned NORMAL_OFFSET = 5;
+  //! Most levels of detail a mesh may have, including the full detail one.
+  static const unsigned MAX_LODS = 6;
+
+  //! \return The number of vertices.
+  unsigned VertexCount() const { return unsigned(vertices.size() / VERTEX_FLOATS); }
+  
+  //! \brief Sets bounds_min and bounds_max from the vertex positions.
+  void ComputeBounds();
+  
+  //! \return A view of this data, valid until it is modified.
+  MeshView View() const;
+
+  //! Interleaved vertex data, VERTEX_FLOATS per vertex.
+  std::vector<float> vertices;
+  //! Triangle list indices into vertices, every level of detail back to back.
+  std::vector<unsigned> indices;
+  //! Levels of detail, finest first, empty until GenerateLods is run.
+  std::vector<MeshLod> lods;
+  
+  //! Lower corner of the axis aligned bounds in model space.
+  float bounds_min[3] = {0.0f, 0.0f, 0.0f};
+  //! Upper corner of the axis aligned bounds in model space.
+  float bounds_max[3] = {0.0f, 0.0f, 0.0f};
+};
@@ -0,0 +1,375 @@
+/*! \file MeshOptimizer.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of the mesh reordering passes and analyzers.
+*/
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// HELPER FUNCTIONS START
+
+//! Entries of the LRU cache modelled by OptimizeVertexCache.
+static const unsigned CACHE_SIZE = 32;
+//! Valences above this share the last score.
+static const unsigned MAX_VALENCE = 32;
+static const unsigned NONE = ~0u;
+
+//! Forsyth's vertex scores, indexed by cache position and by remaining triangle count.
+struct ScoreTables
+{
+  ScoreTables()
+  {
+    for (unsigned i = 0; i < CACHE_SIZE; ++i)
+      // the last triangle's vertices score the same, so its winding order is kept
+      cache[i] = i < 3 ? 0.75f : powf(1.0f - float(i - 3) / float(CACHE_SIZE - 3), 1.5f);
+    valence[0] = 0.0f;
+    for (unsigned i = 1; i <= MAX_VALENCE; ++i)
+      valence[i] = 2.0f / sqrtf(float(i));
+  }
+  
+  float cache[CACHE_SIZE];
+  float valence[MAX_VALENCE + 1];
+};
+
+static const ScoreTables SCORES;
+
+static float VertexScore(unsigned cache_position, unsigned remaining)
+{
+  if (remaining == 0)
+    return -1.0f;
+  float score = cache_position < CACHE_SIZE ? SCORES.cache[cache_position] : 0.0f;
+  return score + SCORES.valence[remaining < MAX_VALENCE ? remaining : MAX_VALENCE];
+}
+
+static void Subtract(const float* a, const float* b, float* out)
+{
+  out[0] = a[0] - b[0];
+  out[1] = a[1] - b[1];
+  out[2] = a[2] - b[2];
+}
+
+static void Cross(const float* a, const float* b, float* out)
+{
+  out[0] = a[1] * b[2] - a[2] * b[1];
+  out[1] = a[2] * b[0] - a[0] * b[2];
+  out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+// HELPER FUNCTIONS END
+
+void OptimizeVertexCache(unsigned* indices, size_t index_count, unsigned vertex_count)
+{
+  size_t triangle_count = index_count / 3;
+  if (triangle_count == 0)
+    return;
+  
+  // triangles of each vertex, live ones are kept at the front of each list
+  std::vector<unsigned> remaining(vertex_count, 0);
+  for (size_t i = 0; i < triangle_count * 3; ++i)
+    ++remaining[indices[i]];
+  std::vector<unsigned> first(vertex_count + 1, 0);
+  for (unsigned v = 0; v < vertex_count; ++v)
+    first[v + 1] = first[v] + remaining[v];
+  std::vector<unsigned> adjacency(triangle_count * 3);
+  std::vector<unsigned> cursor(first.begin(), first.end() - 1);
+  for (size_t i = 0; i < triangle_count * 3; ++i)
+    adjacency[cursor[indices[i]]++] = unsigned(i / 3);
+  
+  std::vector<float> vertex_score(vertex_count);
+  for (unsigned v = 0; v < vertex_count; ++v)
+    vertex_score[v] = VertexScore(CACHE_SIZE, remaining[v]);
+  
+  std::vector<float> triangle_score(triangle_count);
+  std::vector<bool> emitted(triangle_count, false);
+  unsigned best = 0;
+  for (size_t t = 0; t < triangle_count; ++t)
+  {
+    const unsigned* tri = indices + t * 3;
+    triangle_score[t] = vertex_score[tri[0]] + vertex_score[tri[1]] + vertex_score[tri[2]];
+    if (triangle_score[t] > triangle_score[best])
+      best = unsigned(t);
+  }
+  
+  std::vector<unsigned> output(triangle_count * 3);
+  unsigned cache[CACHE_SIZE + 3];
+  unsigned cache_count = 0;
+  size_t scan = 0;
+  
+  for (size_t emitted_count = 0; emitted_count < triangle_count; ++emitted_count)
+  {
+    // nothing in the cache has triangles left, restart from the next unemitted one
+    if (best == NONE)
+    {
+      while (emitted[scan])
+        ++scan;
+      best = unsigned(scan);
+    }
+    
+    const unsigned* tri = indices + size_t(best) * 3;
+    memcpy(&output[emitted_count * 3], tri, 3 * sizeof(unsigned));
+    emitted[best] = true;
+    
+    for (unsigned corner = 0; corner < 3; ++corner)
+    {
+      unsigned v = tri[corner];
+      unsigned* list = &adjacency[first[v]];
+      unsigned* found = std::find(list, list + remaining[v], best);
+      *found = list[--remaining[v]];
+    }
+    
+    // the triangle's vertices move to the front, the rest shift back
+    unsigned next_cache[CACHE_SIZE + 3];
+    unsigned next_count = 0;
+    for (unsigned corner = 0; corner < 3; ++corner)
+      next_cache[next_count++] = tri[corner];
+    for (unsigned i = 0; i < cache_count; ++i)
+      if (cache[i] != tri[0] && cache[i] != tri[1] && cache[i] != tri[2])
+        next_cache[next_count++] = cache[i];
+    
+    // vertices pushed out of the cache lose their position score
+    for (unsigned i = CACHE_SIZE; i < next_count; ++i)
+    {
+      unsigned v = next_cache[i];
+      vertex_score[v] = VertexScore(CACHE_SIZE, remaining[v]);
+      for (unsigned j = first[v]; j < first[v] + remaining[v]; ++j)
+      {
+        const unsigned* other = indices + size_t(adjacency[j]) * 3;
+        triangle_score[adjacency[j]] = vertex_score[other[0]] + vertex_score[other[1]] + vertex_score[other[2]];
+      }
+    }
+    cache_count = next_count < CACHE_SIZE ? next_count : CACHE_SIZE;
+    memcpy(cache, next_cache, cache_count * sizeof(unsigned));
+    
+    for (unsigned i = 0; i < cache_count; ++i)
+      vertex_score[cache[i]] = VertexScore(i, remaining[cache[i]]);
+    
+    // only triangles touching the cache changed score, the best is among them
+    best = NONE;
+    float best_score = -1.0f;
+    for (unsigned i = 0; i < cache_count; ++i)
+    {
+      unsigned v = cache[i];
+      for (unsigned j = first[v]; j < first[v] + remaining[v]; ++j)
+      {
+        unsigned t = adjacency[j];
+        const unsigned* other = indices + size_t(t) * 3;
+        triangle_score[t] = vertex_score[other[0]] + vertex_score[other[1]] + vertex_score[other[2]];
+        if (triangle_score[t] > best_score)
+        {
+          best = t;
+          best_score = triangle_score[t];
+        }
+      }
+    }
+  }
+  
+  memcpy(indices, output.data(), output.size() * sizeof(unsigned));
+}
+
+void OptimizeOverdraw(unsigned* indices, size_t index_count, const float* vertices, unsigned vertex_count, unsigned vertex_floats, float threshold)
+{
+  size_t triangle_count = index_count / 3;
+  if (triangle_count < 2)
+    return;
+  
+  // split wherever a triangle misses the cache entirely, reordering there costs little
+  std::vector<unsigned> cluster_start;
+  {
+    std::vector<unsigned> timestamp(vertex_count, 0);
+    const unsigned cache_size = 16;
+    unsigned time = cache_size + 1;
+    for (size_t t = 0; t < triangle_count; ++t)
+    {
+      unsigned misses = 0;
+      for (unsigned corner = 0; corner < 3; ++corner)
+      {
+        unsigned v = indices[t * 3 + corner];
+        if (time - timestamp[v] > cache_size)
+        {
+          timestamp[v] = time++;
+          ++misses;
+        }
+      }
+      if (t == 0 || misses == 3)
+        cluster_start.push_back(unsigned(t));
+    }
+  }
+  unsigned cluster_count = unsigned(cluster_start.size());
+  if (cluster_count < 2)
+    return;
+  cluster_start.push_back(unsigned(triangle_count));
+  
+  // area weighted centroids and normals of the mesh and each cluster
+  std::vector<float> cluster_centroid(cluster_count * 3, 0.0f);
+  std::vector<float> cluster_normal(cluster_count * 3, 0.0f);
+  std::vector<float> cluster_area(cluster_count, 0.0f);
+  float mesh_centroid[3] = {0.0f, 0.0f, 0.0f};
+  float mesh_area = 0.0f;
+  for (unsigned c = 0; c < cluster_count; ++c)
+  {
+    for (unsigned t = cluster_start[c]; t < cluster_start[c + 1]; ++t)
+    {
+      const float* a = vertices + size_t(indices[t * 3]) * vertex_floats;
+      const float* b = vertices + size_t(indices[t * 3 + 1]) * vertex_floats;
+      const float* d = vertices + size_t(indices[t * 3 + 2]) * vertex_floats;
+      float e1[3], e2[3], n[3];
+      Subtract(b, a, e1);
+      Subtract(d, a, e2);
+      Cross(e1, e2, n);
+      float area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      for (unsigned axis = 0; axis < 3; ++axis)
+      {
+        float center = (a[axis] + b[axis] + d[axis]) * (1.0f / 3.0f);
+        cluster_centroid[c * 3 + axis] += center * area;
+        cluster_normal[c * 3 + axis] += n[axis];
+        mesh_centroid[axis] += center * area;
+      }
+      cluster_area[c] += area;
+      mesh_area += area;
+    }
+  }
+  if (mesh_area <= 0.0f)
+    return;
+  for (unsigned axis = 0; axis < 3; ++axis)
+    mesh_centroid[axis] /= mesh_area;
+  
+  // clusters facing away from the center are likely in front, so they go first
+  std::vector<float> key(cluster_count, 0.0f);
+  for (unsigned c = 0; c < cluster_count; ++c)
+  {
+    if (cluster_area[c] <= 0.0f)
+      continue;
+    const float* n = &cluster_normal[c * 3];
+    float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length <= 0.0f)
+      continue;
+    for (unsigned axis = 0; axis < 3; ++axis)
+      key[c] += (cluster_centroid[c * 3 + axis] / cluster_area[c] - mesh_centroid[axis]) * n[axis] / length;
+  }
+  std::vector<unsigned> order(cluster_count);
+  for (unsigned c = 0; c < cluster_count; ++c)
+    order[c] = c;
+  std::stable_sort(order.begin(), order.end(), [&key](unsigned a, unsigned b) { return key[a] > key[b]; });
+  
+  std::vector<unsigned> output;
+  output.reserve(triangle_count * 3);
+  for (unsigned c : order)
+    output.insert(output.end(), indices + size_t(cluster_start[c]) * 3, indices + size_t(cluster_start[c + 1]) * 3);
+  
+  float before = AnalyzeVertexCache(indices, index_count, vertex_count).acmr;
+  float after = AnalyzeVertexCache(output.data(), output.size(), vertex_count).acmr;
+  if (after <= before * threshold)
+    memcpy(indices, output.data(), output.size() * sizeof(unsigned));
+}
+
+unsigned OptimizeVertexFetch(float* vertices, unsigned vertex_count, unsigned vertex_floats, unsigned* indices, size_t index_count)
+{
+  std::vector<unsigned> remap(vertex_count, NONE);
+  std::vector<float> output;
+  output.reserve(size_t(vertex_count) * vertex_floats);
+  
+  unsigned next = 0;
+  for (size_t i = 0; i < index_count; ++i)
+  {
+    unsigned& mapped = remap[indices[i]];
+    if (mapped == NONE)
+    {
+      const float* vertex = vertices + size_t(indices[i]) * vertex_floats;
+      output.insert(output.end(), vertex, vertex + vertex_floats);
+      mapped = next++;
+    }
+    indices[i] = mapped;
+  }
+  
+  memcpy(vertices, output.data(), output.size() * sizeof(float));
+  return next;
+}
+
+void OptimizeMesh(MeshData& mesh)
+{
+  size_t index_count = mesh.indices.size() - mesh.indices.size() % 3;
+  
+  // each level of detail is drawn on its own, so each is ordered on its own
+  if (mesh.lods.empty())
+    mesh.lods.push_back(MeshLod{0, unsigned(index_count), 0.0f});
+  for (const MeshLod& lod : mesh.lods)
+  {
+    unsigned* indices = mesh.indices.data() + lod.index_offset;
+    OptimizeVertexCache(indices, lod.index_count, mesh.VertexCount());
+    OptimizeOverdraw(indices, lod.index_count, mesh.vertices.data(), mesh.VertexCount(), MeshData::VERTEX_FLOATS);
+  }
+  
+  // full detail comes first, so coarser levels reuse its first vertices
+  unsigned used = OptimizeVertexFetch(mesh.vertices.data(), mesh.VertexCount(), MeshData::VERTEX_FLOATS, mesh.indices.data(), index_count);
+  mesh.vertices.resize(size_t(used) * MeshData::VERTEX_FLOATS);
+}
+
+VertexCacheStats AnalyzeVertexCache(const unsigned* indices, size_t index_count, unsigned vertex_count, unsigned cache_size)
+{
+  VertexCacheStats stats;
+  if (index_count < 3)
+    return stats;
+  
+  // a vertex is cached while fewer than cache_size misses happened since its own
+  std::vector<unsigned> timestamp(vertex_count, 0);
+  std::vector<bool> used(vertex_count, false);
+  unsigned time = cache_size + 1;
+  unsigned unique = 0;
+  for (size_t i = 0; i < index_count; ++i)
+  {
+    unsigned v = indices[i];
+    if (time - timestamp[v] > cache_size)
+    {
+      timestamp[v] = time++;
+      ++stats.transformed;
+    }
+    if (!used[v])
+    {
+      used[v] = true;
+      ++unique;
+    }
+  }
+  
+  stats.acmr = float(stats.transformed) / float(index_count / 3);
+  stats.atvr = float(stats.transformed) / float(unique);
+  return stats;
+}
+
+VertexFetchStats AnalyzeVertexFetch(const unsigned* indices, size_t index_count, unsigned vertex_count, unsigned vertex_size)
+{
+  VertexFetchStats stats;
+  if (index_count == 0)
+    return stats;
+  
+  const unsigned LINE_SIZE = 64;
+  const unsigned LINE_COUNT = 64;
+  size_t lines[LINE_COUNT];
+  for (unsigned i = 0; i < LINE_COUNT; ++i)
+    lines[i] = ~size_t(0);
+  
+  std::vector<bool> used(vertex_count, false);
+  size_t unique = 0;
+  for (size_t i = 0; i < index_count; ++i)
+  {
+    unsigned v = indices[i];
+    unique += !used[v];
+    used[v] = true;
+    
+    size_t begin = size_t(v) * vertex_size / LINE_SIZE;
+    size_t end = (size_t(v) * vertex_size + vertex_size - 1) / LINE_SIZE;
+    for (size_t line = begin; line <= end; ++line)
+      if (lines[line % LINE_COUNT] != line)
+      {
+        lines[line % LINE_COUNT] = line;
+        stats.bytes_fetched += LINE_SIZE;
+      }
+  }
+  
+  stats.overfetch = float(stats.bytes_fetched) / float(unique * vertex_size);
+  return stats;
+}
@@ -0,0 +1,84 @@
+/*! \file MeshOptimizer.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains the import time triangle and vertex reordering passes and their offline analyzers.
+*/
+
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstddef>
+
+//! Post-transform cache efficiency of an index buffer, from a FIFO cache simulation.
+struct VertexCacheStats
+{
+  //! Number of vertices the simulated GPU had to transform.
+  unsigned transformed = 0;
+  //! Average cache miss ratio, transformed vertices per triangle. 0.5 is ideal for large grids, 3 is worst.
+  float acmr = 0.0f;
+  //! Average transform to vertex ratio, transformed vertices per unique vertex. 1 is ideal.
+  float atvr = 0.0f;
+};
+
+//! Memory fetch efficiency of an index buffer, from a simulated cache of 64 byte lines.
+struct VertexFetchStats
+{
+  //! Bytes read from the vertex buffer.
+  size_t bytes_fetched = 0;
+  //! Bytes fetched per byte of vertex data. 1 is ideal.
+  float overfetch = 0.0f;
+};
+
+/*! \brief Reorders triangles to reuse the post-transform vertex cache, using Forsyth's linear speed algorithm.
+    \param indices The triangle list, reordered in place.
+    \param index_count The number of indices.
+    \param vertex_count The number of vertices the indices refer to.
+*/
+void OptimizeVertexCache(unsigned* indices, size_t index_count, unsigned vertex_count);
+
+/*! \brief Reorders clusters of triangles so outward facing ones draw first, reducing overdraw.
+
+    Clusters are split where the vertex cache would miss anyway, so the
+    vertex cache order is mostly kept. Should run after OptimizeVertexCache.
+    \param indices The triangle list, reordered in place.
+    \param index_count The number of indices.
+    \param vertices Interleaved vertices with the position first.
+    \param vertex_count The number of vertices.
+    \param vertex_floats The number of floats per vertex.
+    \param threshold The ACMR may grow by at most this factor, otherwise the order is left unchanged.
+*/
+void OptimizeOverdraw(unsigned* indices, size_t index_count, const float* vertices, unsigned vertex_count, unsigned vertex_floats, float threshold = 1.05f);
+
+/*! \brief Reorders vertices into the order they are first used, dropping unused ones.
+    \param vertices Interleaved vertices, reordered in place.
+    \param vertex_count The number of vertices.
+    \param vertex_floats The number of floats per vertex.
+    \param indices The triangle list, remapped in place.
+    \param index_count The number of indices.
+    \return The number of vertices left.
+*/
+unsigned OptimizeVertexFetch(float* vertices, unsigned vertex_count, unsigned vertex_floats, unsigned* indices, size_t index_count);
+
+/*! \brief Runs the vertex cache and overdraw passes on each level of detail, then the vertex fetch pass.
+    \param mesh The mesh to optimize, vertices and indices are replaced. A single level is added if it has none.
+*/
+void OptimizeMesh(MeshData& mesh);
+
+/*! \brief Simulates a FIFO post-transform cache over an index buffer.
+    \param indices The triangle list.
+    \param index_count The number of indices.
+    \param vertex_count The number of vertices the indices refer to.
+    \param cache_size The number of cache entries to simulate.
+    \return The cache statistics.
+*/
+VertexCacheStats AnalyzeVertexCache(const unsigned* indices, size_t index_count, unsigned vertex_count, unsigned cache_size = 16);
+
+/*! \brief Simulates a direct mapped cache of 64 byte lines over the vertex reads of an index buffer.
+    \param indices The triangle list.
+    \param index_count The number of indices.
+    \param vertex_count The number of vertices the indices refer to.
+    \param vertex_size The size of a vertex in bytes.
+    \return The fetch statistics.
+*/
+VertexFetchStats AnalyzeVertexFetch(const unsigned* indices, size_t index_count, unsigned vertex_count, unsigned vertex_size);
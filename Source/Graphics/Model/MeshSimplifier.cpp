@@ -0,0 +1,315 @@
+/*! \file MeshSimplifier.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of the quadric error metric simplifier.
+*/
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+// HELPER FUNCTIONS START
+
+//! Largest error a level of detail may add, relative to the bounding sphere radius.
+static const float MAX_LOD_ERROR = 0.05f;
+//! A level must drop at least this fraction of the previous level's triangles to be kept.
+static const float MIN_LOD_REDUCTION = 0.15f;
+//! Levels are not simplified below this many triangles.
+static const size_t MIN_LOD_TRIANGLES = 16;
+
+//! Symmetric 4x4 matrix summing squared distances to a set of planes.
+struct Quadric
+{
+  double a2, b2, c2, d2, ab, ac, ad, bc, bd, cd;
+  //! Total plane weight, dividing by it turns the sum into an average.
+  double weight;
+
+  void AddPlane(const double* n, double d, double weight)
+  {
+    a2 += weight * n[0] * n[0];
+    b2 += weight * n[1] * n[1];
+    c2 += weight * n[2] * n[2];
+    d2 += weight * d * d;
+    ab += weight * n[0] * n[1];
+    ac += weight * n[0] * n[2];
+    ad += weight * n[0] * d;
+    bc += weight * n[1] * n[2];
+    bd += weight * n[1] * d;
+    cd += weight * n[2] * d;
+    this->weight += weight;
+  }
+
+  void Add(const Quadric& rhs)
+  {
+    a2 += rhs.a2; b2 += rhs.b2; c2 += rhs.c2; d2 += rhs.d2; ab += rhs.ab;
+    ac += rhs.ac; ad += rhs.ad; bc += rhs.bc; bd += rhs.bd; cd += rhs.cd;
+    weight += rhs.weight;
+  }
+
+  //! Squared distance of p to the planes, averaged by area.
+  double Evaluate(const double* p) const
+  {
+    double x = p[0], y = p[1], z = p[2];
+    double sum = a2 * x * x + b2 * y * y + c2 * z * z + d2 + 2.0 * (ab * x * y + ac * x * z + ad * x + bc * y * z + bd * y + cd * z);
+    return weight > 0.0 ? sum / weight : sum;
+  }
+};
+
+struct Collapse
+{
+  unsigned from;
+  unsigned to;
+  double cost;
+};
+
+static void TriangleNormal(const double* a, const double* b, const double* c, double* n)
+{
+  double e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  double e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+  n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+  n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+static unsigned long long EdgeKey(unsigned a, unsigned b)
+{
+  return a < b ? (static_cast<unsigned long long>(a) << 32) | b : (static_cast<unsigned long long>(b) << 32) | a;
+}
+
+// HELPER FUNCTIONS END
+
+size_t SimplifyMesh(unsigned* destination, const unsigned* indices, size_t index_count, const float* vertices, unsigned vertex_count, unsigned vertex_floats,
+                    size_t target_index_count, float target_error, float* result_error)
+{
+  index_count -= index_count % 3;
+  std::vector<unsigned> result(indices, indices + index_count);
+  if (result_error)
+    *result_error = 0.0f;
+
+  // positions centered and scaled to the unit sphere, so errors are relative to the radius
+  std::vector<double> position(size_t(vertex_count) * 3);
+  {
+    float low[3] = {0.0f, 0.0f, 0.0f}, high[3] = {0.0f, 0.0f, 0.0f};
+    for (unsigned v = 0; v < vertex_count; ++v)
+      for (unsigned axis = 0; axis < 3; ++axis)
+      {
+        float value = vertices[size_t(v) * vertex_floats + axis];
+        low[axis] = v == 0 || value < low[axis] ? value : low[axis];
+        high[axis] = v == 0 || value > high[axis] ? value : high[axis];
+      }
+    double extent[3] = {high[0] - low[0], high[1] - low[1], high[2] - low[2]};
+    double radius = 0.5 * sqrt(extent[0] * extent[0] + extent[1] * extent[1] + extent[2] * extent[2]);
+    double scale = radius > 0.0 ? 1.0 / radius : 1.0;
+    for (unsigned v = 0; v < vertex_count; ++v)
+      for (unsigned axis = 0; axis < 3; ++axis)
+        position[size_t(v) * 3 + axis] = (vertices[size_t(v) * vertex_floats + axis] - 0.5 * (low[axis] + high[axis])) * scale;
+  }
+
+  // vertices sharing a position map to the first of them, more than one means a seam
+  std::vector<unsigned> canonical(vertex_count);
+  std::vector<bool> locked(vertex_count, false);
+  {
+    std::vector<unsigned> order(vertex_count);
+    for (unsigned v = 0; v < vertex_count; ++v)
+      order[v] = v;
+    auto less = [vertices, vertex_floats](unsigned a, unsigned b)
+    {
+      return memcmp(vertices + size_t(a) * vertex_floats, vertices + size_t(b) * vertex_floats, 3 * sizeof(float)) < 0;
+    };
+    std::sort(order.begin(), order.end(), less);
+    for (unsigned i = 0; i < vertex_count;)
+    {
+      unsigned end = i + 1;
+      while (end < vertex_count && !less(order[i], order[end]))
+        ++end;
+      unsigned first = *std::min_element(order.begin() + i, order.begin() + end);
+      for (unsigned j = i; j < end; ++j)
+      {
+        canonical[order[j]] = first;
+        locked[order[j]] = end - i > 1;
+      }
+      i = end;
+    }
+  }
+
+  // edges with one triangle are open borders, more than two are non-manifold, neither may move
+  {
+    std::unordered_map<unsigned long long, unsigned> edge_use;
+    edge_use.reserve(index_count);
+    for (size_t i = 0; i < index_count; i += 3)
+      for (unsigned corner = 0; corner < 3; ++corner)
+        ++edge_use[EdgeKey(canonical[result[i + corner]], canonical[result[i + (corner + 1) % 3]])];
+    std::vector<bool> border(vertex_count, false);
+    for (auto it = edge_use.begin(); it != edge_use.end(); ++it)
+      if (it->second != 2)
+      {
+        border[unsigned(it->first >> 32)] = true;
+        border[unsigned(it->first & 0xFFFFFFFFu)] = true;
+      }
+    for (unsigned v = 0; v < vertex_count; ++v)
+      locked[v] = locked[v] || border[canonical[v]];
+  }
+
+  // area weighted plane quadrics, shared by every vertex at a position
+  std::vector<Quadric> quadric(vertex_count);
+  memset(quadric.data(), 0, quadric.size() * sizeof(Quadric));
+  for (size_t i = 0; i < index_count; i += 3)
+  {
+    const double* a = &position[size_t(result[i]) * 3];
+    const double* b = &position[size_t(result[i + 1]) * 3];
+    const double* c = &position[size_t(result[i + 2]) * 3];
+    double n[3];
+    TriangleNormal(a, b, c, n);
+    double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length <= 0.0)
+      continue;
+    n[0] /= length; n[1] /= length; n[2] /= length;
+    double d = -(n[0] * a[0] + n[1] * a[1] + n[2] * a[2]);
+    for (unsigned corner = 0; corner < 3; ++corner)
+      quadric[canonical[result[i + corner]]].AddPlane(n, d, length * 0.5);
+  }
+
+  double max_cost = double(target_error) * double(target_error);
+  double worst = 0.0;
+  std::vector<unsigned> first(vertex_count + 1);
+  std::vector<unsigned> adjacency;
+  std::vector<Collapse> candidates;
+  std::vector<unsigned> collapse_to(vertex_count);
+  std::vector<bool> touched(vertex_count);
+
+  while (result.size() > target_index_count)
+  {
+    size_t triangle_count = result.size() / 3;
+
+    // triangles around each vertex
+    std::fill(first.begin(), first.end(), 0u);
+    for (unsigned v : result)
+      ++first[v + 1];
+    for (unsigned v = 0; v < vertex_count; ++v)
+      first[v + 1] += first[v];
+    adjacency.resize(result.size());
+    std::vector<unsigned> cursor(first.begin(), first.end() - 1);
+    for (size_t i = 0; i < result.size(); ++i)
+      adjacency[cursor[result[i]]++] = unsigned(i / 3);
+
+    candidates.clear();
+    for (size_t i = 0; i < result.size(); i += 3)
+      for (unsigned corner = 0; corner < 3; ++corner)
+      {
+        unsigned from = result[i + corner];
+        unsigned to = result[i + (corner + 1) % 3];
+        // interior edges show up once in each direction, one of them covers both collapses
+        if (from > to)
+          continue;
+        for (unsigned pass = 0; pass < 2; ++pass, std::swap(from, to))
+        {
+          if (locked[from])
+            continue;
+          Quadric sum = quadric[canonical[from]];
+          sum.Add(quadric[canonical[to]]);
+          double cost = sum.Evaluate(&position[size_t(to) * 3]);
+          cost = cost > 0.0 ? cost : 0.0;
+          if (cost <= max_cost)
+            candidates.push_back(Collapse{from, to, cost});
+        }
+      }
+    if (candidates.empty())
+      break;
+    std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+    // each collapse removes about two triangles, vertices around a collapse wait for the next pass
+    size_t budget = (triangle_count - target_index_count / 3) / 2 + 1;
+    size_t collapses = 0;
+    for (unsigned v = 0; v < vertex_count; ++v)
+      collapse_to[v] = v;
+    std::fill(touched.begin(), touched.end(), false);
+
+    for (size_t c = 0; c < candidates.size() && collapses < budget; ++c)
+    {
+      const Collapse& collapse = candidates[c];
+      if (touched[collapse.from] || touched[collapse.to])
+        continue;
+
+      // reject collapses that would flip a remaining triangle
+      bool flips = false;
+      const double* target = &position[size_t(collapse.to) * 3];
+      for (unsigned j = first[collapse.from]; j < first[collapse.from + 1] && !flips; ++j)
+      {
+        const unsigned* tri = &result[size_t(adjacency[j]) * 3];
+        if (tri[0] == collapse.to || tri[1] == collapse.to || tri[2] == collapse.to)
+          continue;
+        const double* corners[3];
+        for (unsigned corner = 0; corner < 3; ++corner)
+          corners[corner] = &position[size_t(tri[corner]) * 3];
+        double before[3], after[3];
+        TriangleNormal(corners[0], corners[1], corners[2], before);
+        for (unsigned corner = 0; corner < 3; ++corner)
+          corners[corner] = tri[corner] == collapse.from ? target : corners[corner];
+        TriangleNormal(corners[0], corners[1], corners[2], after);
+        flips = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0;
+      }
+      if (flips)
+        continue;
+
+      collapse_to[collapse.from] = collapse.to;
+      for (unsigned j = first[collapse.from]; j < first[collapse.from + 1]; ++j)
+        for (unsigned corner = 0; corner < 3; ++corner)
+          touched[result[size_t(adjacency[j]) * 3 + corner]] = true;
+      quadric[canonical[collapse.to]].Add(quadric[canonical[collapse.from]]);
+      worst = collapse.cost > worst ? collapse.cost : worst;
+      ++collapses;
+    }
+    if (!collapses)
+      break;
+
+    // remap and drop triangles that lost their area
+    size_t write = 0;
+    for (size_t i = 0; i < result.size(); i += 3)
+    {
+      unsigned a = collapse_to[result[i]], b = collapse_to[result[i + 1]], c = collapse_to[result[i + 2]];
+      if (canonical[a] == canonical[b] || canonical[b] == canonical[c] || canonical[a] == canonical[c])
+        continue;
+      result[write++] = a;
+      result[write++] = b;
+      result[write++] = c;
+    }
+    result.resize(write);
+  }
+
+  if (result_error)
+    *result_error = float(sqrt(worst));
+  memcpy(destination, result.data(), result.size() * sizeof(unsigned));
+  return result.size();
+}
+
+void GenerateLods(MeshData& mesh)
+{
+  mesh.lods.clear();
+  size_t full_count = mesh.indices.size() - mesh.indices.size() % 3;
+  mesh.indices.resize(full_count);
+  mesh.lods.push_back(MeshLod{0, unsigned(full_count), 0.0f});
+
+  std::vector<unsigned> level(full_count);
+  while (mesh.lods.size() < MeshData::MAX_LODS)
+  {
+    // simplify the previous level, cheaper than starting from full detail each time
+    MeshLod previous = mesh.lods.back();
+    if (previous.index_count / 3 <= MIN_LOD_TRIANGLES)
+      break;
+
+    size_t target = (previous.index_count / 3 / 2) * 3;
+    float error = 0.0f;
+    size_t count = SimplifyMesh(level.data(), mesh.indices.data() + previous.index_offset, previous.index_count,
+                                mesh.vertices.data(), mesh.VertexCount(), MeshData::VERTEX_FLOATS, target, MAX_LOD_ERROR, &error);
+    if (count > previous.index_count * (1.0f - MIN_LOD_REDUCTION))
+      break;
+
+    // errors of successive levels add up at worst
+    mesh.lods.push_back(MeshLod{unsigned(mesh.indices.size()), unsigned(count), previous.error + error});
+    mesh.indices.insert(mesh.indices.end(), level.begin(), level.begin() + count);
+  }
+}
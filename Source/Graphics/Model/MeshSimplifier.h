@@ -0,0 +1,38 @@
+/*! \file MeshSimplifier.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains the quadric error metric simplifier that builds level of detail chains at import.
+*/
+
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstddef>
+
+/*! \brief Simplifies a triangle list by collapsing edges in order of quadric error.
+
+    Vertices are only moved onto existing vertices, so the result indexes the
+    same vertex buffer. Vertices on a UV or normal seam, where several
+    vertices share a position, and vertices on open borders never move.
+    \param destination Receives the simplified triangle list, room for index_count indices.
+    \param indices The triangle list to simplify.
+    \param index_count The number of indices.
+    \param vertices Interleaved vertices with the position first.
+    \param vertex_count The number of vertices.
+    \param vertex_floats The number of floats per vertex.
+    \param target_index_count Stop once at most this many indices are left.
+    \param target_error Never collapse an edge with a larger error, relative to the bounding sphere radius.
+    \param result_error Set to the largest error of any collapse made, may be nullptr.
+    \return The number of indices written to destination.
+*/
+size_t SimplifyMesh(unsigned* destination, const unsigned* indices, size_t index_count, const float* vertices, unsigned vertex_count, unsigned vertex_floats,
+                    size_t target_index_count, float target_error, float* result_error = nullptr);
+
+/*! \brief Appends up to MeshData::MAX_LODS - 1 simplified levels after the full detail indices.
+
+    Each level targets half the triangles of the one before it. The chain
+    stops early once the error limit keeps a level from shrinking much.
+    \param mesh The mesh to add levels to, any existing levels are replaced.
+*/
+void GenerateLods(MeshData& mesh);
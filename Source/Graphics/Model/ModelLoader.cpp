@@ -0,0 +1,99 @@
+/*! \file ModelLoader.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of ModelLoader class.
+*/
+
+#include "ModelLoader.h"
+#include "../../Debug/DebugLog.h"
+
+const char* MODEL_FOLDER_PATH = "../Assets/Models/";
+
+ModelLoader::ModelLoader() : pending_(0)
+{
+}
+
+void ModelLoader::Initialize()
+{
+  workers_.reset(new ThreadPool());
+}
+
+void ModelLoader::Exit()
+{
+  if (workers_)
+    workers_->Wait(in_flight_);
+  workers_.reset();
+  
+  for (auto it = meshes_.begin(); it != meshes_.end(); ++it)
+    it->second->Release();
+  meshes_.clear();
+  finished_.clear();
+  uploading_.clear();
+  pending_ = 0;
+}
+
+Mesh* ModelLoader::Load(const char* file)
+{
+  auto found = meshes_.find(file);
+  if (found != meshes_.end())
+    return found->second.get();
+  
+  Mesh* mesh = new Mesh(file);
+  meshes_.emplace(file, std::unique_ptr<Mesh>(mesh));
+  ++pending_;
+  
+  std::string path = std::string(MODEL_FOLDER_PATH) + file;
+  workers_->Submit([this, mesh, path]()
+  {
+    Finished_ result;
+    result.mesh = mesh;
+    // large files are split across the same workers, waiting here helps run the pieces
+    result.success = ImportMesh(path.c_str(), result.import, workers_.get());
+    
+    std::lock_guard<std::mutex> lock(finished_mutex_);
+    finished_.push_back(std::move(result));
+  }, &in_flight_);
+  
+  return mesh;
+}
+
+void ModelLoader::UploadFinished(size_t byte_budget, std::vector<Uploaded>& uploaded)
+{
+  if (uploading_.empty())
+  {
+    std::lock_guard<std::mutex> lock(finished_mutex_);
+    uploading_.swap(finished_);
+  }
+  
+  size_t bytes = 0;
+  size_t done = 0;
+  while (done < uploading_.size() && (done == 0 || bytes < byte_budget))
+  {
+    Finished_& result = uploading_[done++];
+    uploaded.push_back(Uploaded{result.mesh, result.success});
+    
+    if (!result.success)
+    {
+      LOG_MARKED("Model " << result.mesh->name << " failed to import", '!');
+      continue;
+    }
+    
+    // cached meshes upload straight from the mapping
+    MeshView view = result.import.View();
+    result.mesh->Upload(view);
+    bytes += size_t(view.vertex_count) * MeshData::VERTEX_FLOATS * sizeof(float) + size_t(view.index_count) * sizeof(unsigned);
+    LOG("Model " << result.mesh->name << (result.import.from_cache ? " loaded from cache" : " loaded"));
+  }
+  
+  // keep the remainder for next frame, this also unmaps uploaded caches
+  uploading_.erase(uploading_.begin(), uploading_.begin() + done);
+}
+
+void ModelLoader::Publish(const std::vector<Uploaded>& uploaded)
+{
+  for (const Uploaded& result : uploaded)
+  {
+    result.mesh->state = result.success ? Mesh::Ready : Mesh::Failed;
+    --pending_;
+  }
+}
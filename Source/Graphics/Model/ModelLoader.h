@@ -0,0 +1,90 @@
+/*! \file ModelLoader.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains ModelLoader class, which imports models on worker threads and uploads them on the GL thread.
+*/
+
+#pragma once
+
+#include "MeshCache.h"
+#include "../LowLevel/Mesh.h"
+#include "../../Threading/ThreadPool.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//! Used to identify model source folder.
+extern const char* MODEL_FOLDER_PATH;
+
+/*! Owns every Mesh, one per model file.
+
+    Load returns immediately with a Mesh in the Loading state while a worker
+    imports the file through the binary mesh cache, parsing it only when the
+    cache is missing or stale. UploadFinished, called once per frame on the GL thread,
+    uploads parsed meshes within a byte budget so a burst of finished imports
+    is spread over several frames instead of stalling one. The meshes it
+    uploaded are handed back through Publish on the thread drawing objects,
+    so Mesh::state only changes on that thread.
+*/
+class ModelLoader
+{
+  public:
+    //! An import UploadFinished is done with, waiting for Publish.
+    struct Uploaded
+    {
+      Mesh* mesh;
+      bool success;
+    };
+    
+    ModelLoader();
+    
+    //! \brief Starts the worker threads.
+    void Initialize();
+    
+    //! \brief Waits for in-flight imports and frees every Mesh, must be called on the GL thread.
+    void Exit();
+    
+    /*! \brief Returns the Mesh of a model file, starting an import if it is not known yet.
+        \param file The file, relative to MODEL_FOLDER_PATH.
+        \return The shared Mesh, in the Loading state until its import is uploaded.
+    */
+    Mesh* Load(const char* file);
+    
+    /*! \brief Uploads finished imports, must be called on the GL thread.
+        \param byte_budget Stop uploading once this many bytes were sent, at least one import is always uploaded.
+        \param uploaded Receives the imports done with, appended, to be passed to Publish.
+    */
+    void UploadFinished(size_t byte_budget, std::vector<Uploaded>& uploaded);
+    
+    /*! \brief Marks uploaded meshes Ready or Failed, must be called on the thread that called Load.
+        \param uploaded Imports from UploadFinished, once the GL thread is done with them.
+    */
+    void Publish(const std::vector<Uploaded>& uploaded);
+    
+    //! \return The number of imports not yet uploaded.
+    unsigned Pending() const { return pending_; }
+    //! \return The number of meshes, loaded or not.
+    unsigned MeshCount() const { return unsigned(meshes_.size()); }
+    
+  private:
+    //! The result of a worker import.
+    struct Finished_
+    {
+      Mesh* mesh;
+      ImportedMesh import;
+      bool success;
+    };
+  
+    std::unique_ptr<ThreadPool> workers_;
+    std::unordered_map<std::string, std::unique_ptr<Mesh>> meshes_;
+    //! Imports waiting for upload, filled by workers.
+    std::vector<Finished_> finished_;
+    //! Imports being uploaded, swapped with finished_ so workers are not blocked during upload.
+    std::vector<Finished_> uploading_;
+    std::mutex finished_mutex_;
+    TaskCounter in_flight_;
+    unsigned pending_;
+};
@@ -0,0 +1,368 @@
+/*! \file ObjParser.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of the Wavefront OBJ importer.
+*/
+
+#include "ObjParser.h"
+#include "../../Memory/MappedFile.h"
+#include "../../Threading/ThreadPool.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+// HELPER FUNCTIONS START
+
+namespace
+{
+  //! Chunks smaller than this are not worth a task of their own.
+  const size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+  // bit set in Corner::relative for each index that was negative in the file
+  const unsigned char RELATIVE_POSITION = 0x01;
+  const unsigned char RELATIVE_UV = 0x02;
+  const unsigned char RELATIVE_NORMAL = 0x04;
+
+  /*! One corner of a face. Indices are 1-based and global, 0 if absent,
+      unless flagged in relative, in which case they are 1-based from the start
+      of their chunk (and may be 0 or negative to reach into earlier chunks)
+      since a chunk does not know how many vertices came before it.
+  */
+  struct Corner
+  {
+    int position;
+    int uv;
+    int normal;
+    unsigned char relative;
+  };
+
+  //! Everything read from one line aligned slice of the file.
+  struct Chunk
+  {
+    const char* begin;
+    const char* end;
+    std::vector<float> positions;
+    std::vector<float> uvs;
+    std::vector<float> normals;
+    std::vector<Corner> corners;
+    //! Corners in each face, faces are stored back to back in corners.
+    std::vector<unsigned> face_sizes;
+
+    //! Number of positions, uvs, and normals in earlier chunks.
+    int position_base;
+    int uv_base;
+    int normal_base;
+  };
+
+  //! A unique vertex in the chain of its position's bucket.
+  struct VertexEntry
+  {
+    int uv;
+    int normal;
+    //! Next vertex with the same position, ~0u ends the chain.
+    unsigned next;
+  };
+}
+
+static inline const char* SkipSpaces(const char* p, const char* end)
+{
+  while (p < end && (*p == ' ' || *p == '\t'))
+    ++p;
+  return p;
+}
+
+// on failure value is 0 and the returned pointer is unchanged
+static inline const char* ParseFloat(const char* p, const char* end, float& value)
+{
+  p = SkipSpaces(p, end);
+  if (p < end && *p == '+')
+    ++p;
+  std::from_chars_result result = std::from_chars(p, end, value);
+  if (result.ec != std::errc())
+    value = 0.0f;
+  return result.ptr;
+}
+
+static inline const char* ParseIndex(const char* p, const char* end, int& value, unsigned char& relative, unsigned char flag, size_t local_count)
+{
+  value = 0;
+  std::from_chars_result result = std::from_chars(p, end, value);
+  if (result.ec != std::errc())
+    value = 0;
+  else if (value < 0)
+  {
+    value += int(local_count) + 1;
+    relative |= flag;
+  }
+  return result.ptr;
+}
+
+static void ParseChunk(Chunk& chunk)
+{
+  const char* p = chunk.begin;
+  const char* end = chunk.end;
+
+  while (p < end)
+  {
+    // memchr is vectorized by every C runtime we build with
+    const char* line_end = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+    if (!line_end)
+      line_end = end;
+
+    p = SkipSpaces(p, line_end);
+    if (line_end - p >= 2)
+    {
+      if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+      {
+        float xyz[3];
+        const char* q = p + 1;
+        for (unsigned i = 0; i < 3; ++i)
+          q = ParseFloat(q, line_end, xyz[i]);
+        chunk.positions.insert(chunk.positions.end(), xyz, xyz + 3);
+      }
+      else if (p[0] == 'v' && p[1] == 't')
+      {
+        float uv[2];
+        const char* q = p + 2;
+        for (unsigned i = 0; i < 2; ++i)
+          q = ParseFloat(q, line_end, uv[i]);
+        chunk.uvs.insert(chunk.uvs.end(), uv, uv + 2);
+      }
+      else if (p[0] == 'v' && p[1] == 'n')
+      {
+        float xyz[3];
+        const char* q = p + 2;
+        for (unsigned i = 0; i < 3; ++i)
+          q = ParseFloat(q, line_end, xyz[i]);
+        chunk.normals.insert(chunk.normals.end(), xyz, xyz + 3);
+      }
+      else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+      {
+        size_t positions = chunk.positions.size() / 3;
+        size_t uvs = chunk.uvs.size() / 2;
+        size_t normals = chunk.normals.size() / 3;
+        unsigned face_size = 0;
+
+        const char* q = p + 1;
+        for (;;)
+        {
+          q = SkipSpaces(q, line_end);
+          if (q >= line_end || *q == '\r' || *q == '#')
+            break;
+
+          // "p", "p/t", "p//n", or "p/t/n"
+          Corner corner = {0, 0, 0, 0};
+          const char* token = q;
+          q = ParseIndex(q, line_end, corner.position, corner.relative, RELATIVE_POSITION, positions);
+          if (q < line_end && *q == '/')
+          {
+            ++q;
+            if (q < line_end && *q != '/')
+              q = ParseIndex(q, line_end, corner.uv, corner.relative, RELATIVE_UV, uvs);
+            if (q < line_end && *q == '/')
+              q = ParseIndex(q + 1, line_end, corner.normal, corner.relative, RELATIVE_NORMAL, normals);
+          }
+
+          // skip anything unparsable up to the next space
+          if (q == token)
+            while (q < line_end && *q != ' ' && *q != '\t')
+              ++q;
+
+          if (corner.position || (corner.relative & RELATIVE_POSITION))
+          {
+            chunk.corners.push_back(corner);
+            ++face_size;
+          }
+        }
+
+        if (face_size)
+          chunk.face_sizes.push_back(face_size);
+      }
+    }
+
+    p = line_end + 1;
+  }
+}
+
+// turns a corner index into a 0-based global index, -1 if absent or out of range
+static inline int ResolveIndex(int index, bool relative, int base, int count)
+{
+  if (relative)
+    index += base;
+  else if (index == 0)
+    return -1;
+  return (index >= 1 && index <= count) ? index - 1 : -1;
+}
+
+// only vertices flagged in missing are changed, so files mixing both keep their normals
+static void GenerateNormals(MeshData& mesh, const std::vector<bool>& missing)
+{
+  float* v = mesh.vertices.data();
+  for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+  {
+    float* a = v + mesh.indices[i] * MeshData::VERTEX_FLOATS;
+    float* b = v + mesh.indices[i + 1] * MeshData::VERTEX_FLOATS;
+    float* c = v + mesh.indices[i + 2] * MeshData::VERTEX_FLOATS;
+    float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    // area weighted, the cross product length is twice the area
+    float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+    for (unsigned corner = 0; corner < 3; ++corner)
+    {
+      unsigned index = mesh.indices[i + corner];
+      if (missing[index])
+        for (unsigned axis = 0; axis < 3; ++axis)
+          v[index * MeshData::VERTEX_FLOATS + MeshData::NORMAL_OFFSET + axis] += n[axis];
+    }
+  }
+
+  for (unsigned i = 0; i < mesh.VertexCount(); ++i)
+  {
+    if (!missing[i])
+      continue;
+    float* n = v + i * MeshData::VERTEX_FLOATS + MeshData::NORMAL_OFFSET;
+    float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length > 0.0f)
+      for (unsigned axis = 0; axis < 3; ++axis)
+        n[axis] /= length;
+  }
+}
+
+// HELPER FUNCTIONS END
+
+bool ParseObj(const char* path, MeshData& mesh, ThreadPool* pool)
+{
+  MappedFile file;
+  if (!file.Open(path))
+    return false;
+  return ParseObjText(file.Data(), file.Size(), mesh, pool);
+}
+
+bool ParseObjText(const char* text, size_t size, MeshData& mesh, ThreadPool* pool)
+{
+  mesh.vertices.clear();
+  mesh.indices.clear();
+  mesh.lods.clear();
+  if (!text || !size)
+    return false;
+
+  // split on line boundaries, a few chunks per thread so uneven chunks balance out
+  size_t chunk_count = 1;
+  if (pool)
+  {
+    size_t by_threads = (pool->ThreadCount() + 1) * 4;
+    size_t by_size = size / MIN_CHUNK_SIZE;
+    chunk_count = by_size < by_threads ? by_size : by_threads;
+    chunk_count = chunk_count ? chunk_count : 1;
+  }
+
+  std::vector<Chunk> chunks(chunk_count);
+  const char* end = text + size;
+  const char* begin = text;
+  for (size_t i = 0; i < chunk_count; ++i)
+  {
+    const char* split = (i + 1 == chunk_count) ? end : text + (size * (i + 1)) / chunk_count;
+    if (split < begin)
+      split = begin;
+    if (split < end)
+    {
+      const char* newline = static_cast<const char*>(memchr(split, '\n', size_t(end - split)));
+      split = newline ? newline + 1 : end;
+    }
+    chunks[i].begin = begin;
+    chunks[i].end = split;
+    begin = split;
+  }
+
+  // parse every chunk, the calling thread takes the first
+  if (pool && chunk_count > 1)
+    pool->ParallelFor(0, unsigned(chunk_count), 1, [&chunks](unsigned chunk, unsigned) { ParseChunk(chunks[chunk]); });
+  else
+    ParseChunk(chunks[0]);
+
+  // concatenate attributes, remembering where each chunk starts
+  std::vector<float> positions, uvs, normals;
+  size_t total_corners = 0;
+  for (Chunk& chunk : chunks)
+  {
+    chunk.position_base = int(positions.size() / 3);
+    chunk.uv_base = int(uvs.size() / 2);
+    chunk.normal_base = int(normals.size() / 3);
+    positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+    uvs.insert(uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+    normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+    total_corners += chunk.corners.size();
+  }
+  int position_count = int(positions.size() / 3);
+  int uv_count = int(uvs.size() / 2);
+  int normal_count = int(normals.size() / 3);
+
+  // the position index is a perfect hash of the corner, so buckets are
+  // indexed by position and chain the rare uv/normal splits of a position.
+  // Neighbouring faces share positions, which keeps bucket lookups in cache.
+  const unsigned NO_VERTEX = ~0u;
+  std::vector<unsigned> bucket(size_t(position_count), NO_VERTEX);
+  std::vector<VertexEntry> entries;
+  entries.reserve(size_t(position_count));
+
+  std::vector<bool> missing_normals;
+  bool needs_normals = false;
+  std::vector<unsigned> face;
+  mesh.indices.reserve(total_corners * 3 / 2);
+  mesh.vertices.reserve(size_t(position_count) * MeshData::VERTEX_FLOATS);
+
+  // deduplicate in file order so the output does not depend on the chunk count
+  for (Chunk& chunk : chunks)
+  {
+    const Corner* corner = chunk.corners.data();
+    for (unsigned face_size : chunk.face_sizes)
+    {
+      face.clear();
+      for (unsigned i = 0; i < face_size; ++i, ++corner)
+      {
+        int p = ResolveIndex(corner->position, (corner->relative & RELATIVE_POSITION) != 0, chunk.position_base, position_count);
+        if (p < 0)
+          continue;
+        int t = ResolveIndex(corner->uv, (corner->relative & RELATIVE_UV) != 0, chunk.uv_base, uv_count);
+        int n = ResolveIndex(corner->normal, (corner->relative & RELATIVE_NORMAL) != 0, chunk.normal_base, normal_count);
+
+        unsigned vertex = bucket[p];
+        while (vertex != NO_VERTEX && (entries[vertex].uv != t || entries[vertex].normal != n))
+          vertex = entries[vertex].next;
+
+        if (vertex == NO_VERTEX)
+        {
+          vertex = unsigned(entries.size());
+          entries.push_back(VertexEntry{t, n, bucket[p]});
+          bucket[p] = vertex;
+
+          float out[MeshData::VERTEX_FLOATS] = {};
+          memcpy(out, &positions[size_t(p) * 3], sizeof(float) * 3);
+          if (t >= 0)
+            memcpy(out + MeshData::UV_OFFSET, &uvs[size_t(t) * 2], sizeof(float) * 2);
+          if (n >= 0)
+            memcpy(out + MeshData::NORMAL_OFFSET, &normals[size_t(n) * 3], sizeof(float) * 3);
+          mesh.vertices.insert(mesh.vertices.end(), out, out + MeshData::VERTEX_FLOATS);
+
+          missing_normals.push_back(n < 0);
+          needs_normals = needs_normals || n < 0;
+        }
+        face.push_back(vertex);
+      }
+
+      // triangulate as a fan
+      for (size_t i = 2; i < face.size(); ++i)
+      {
+        mesh.indices.push_back(face[0]);
+        mesh.indices.push_back(face[i - 1]);
+        mesh.indices.push_back(face[i]);
+      }
+    }
+  }
+
+  if (needs_normals)
+    GenerateNormals(mesh, missing_normals);
+  mesh.ComputeBounds();
+  return !mesh.indices.empty();
+}
@@ -0,0 +1,38 @@
+/*! \file ObjParser.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains the Wavefront OBJ importer.
+*/
+
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstddef>
+
+class ThreadPool;
+
+/*! \brief Parses an OBJ file into indexed, interleaved triangles.
+
+    The file is memory mapped and parsed in place, see ParseObjText.
+    Safe to call from any thread, including workers of pool.
+    \param path The full path of the file.
+    \param mesh Filled with the result, contents are replaced.
+    \param pool Splits parsing across these workers, nullptr parses on the calling thread.
+    \return False if the file could not be read or held no triangles.
+*/
+bool ParseObj(const char* path, MeshData& mesh, ThreadPool* pool = nullptr);
+
+/*! \brief Parses OBJ text into indexed, interleaved triangles.
+
+    The text is split into line aligned chunks that are parsed in parallel,
+    then each unique position/uv/normal combination is hashed into one
+    vertex. Polygons are triangulated as fans and missing normals are
+    generated by averaging face normals.
+    \param text The file contents, need not be null terminated.
+    \param size The number of bytes in text.
+    \param mesh Filled with the result, contents are replaced.
+    \param pool Splits parsing across these workers, nullptr parses on the calling thread.
+    \return False if the text held no triangles.
+*/
+bool ParseObjText(const char* text, size_t size, MeshData& mesh, ThreadPool* pool = nullptr);
@@ -1,16 +1,29 @@
 #include "Object.h"
+#include "Graphics.h"
+#include "RenderQueue.h"
+#include "TransformHierarchy.h"
+#include "LowLevel/Mesh.h"
+#include "LowLevel/Camera.h"
+#include "../Debug/DebugLog.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <string>
 
 #include "ImGui/imgui.h"
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
 
-Object::Object() : ImGuiDraw(nullptr)
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+Object::Object() : ImGuiDraw(nullptr), id(unsigned(-1)), mesh(nullptr), texture(nullptr), opacity(1.0f), lod(0), occluder(false), transforms_(nullptr), transform_(TransformHierarchy::INVALID_HANDLE), parent_id_(unsigned(-1))
 {
 }
 
-Object::Object(unsigned id) : ImGuiDraw(("Object " + std::to_string(id)).c_str()), position(), rotation(), scale(1, 1, 1)
+Object::Object(unsigned id_, TransformHierarchy* transforms) : ImGuiDraw(("Object " + std::to_string(id_)).c_str()), id(id_), mesh(nullptr), texture(nullptr), opacity(1.0f), lod(0), occluder(false), transforms_(transforms), transform_(transforms->Create()), parent_id_(unsigned(-1)), world_radius_(0.0f), world_bounds_(Aabb::Empty()), bounds_version_(0), bounds_mesh_(nullptr)
 {
 
 }
@@ -20,14 +33,128 @@ Object::~Object()
 
 }
 
-void Object::Draw()
+Vector Object::Position() const
+{
+  return transforms_->Position(transform_);
+}
+
+Vector Object::Rotation() const
+{
+  return transforms_->Rotation(transform_);
+}
+
+Vector Object::Scale() const
+{
+  return transforms_->Scale(transform_);
+}
+
+const float* Object::Orientation() const
+{
+  return transforms_->Orientation(transform_);
+}
+
+void Object::SetPosition(const Vector& position)
+{
+  transforms_->SetPosition(transform_, position);
+}
+
+void Object::SetRotation(const Vector& rotation)
+{
+  transforms_->SetRotation(transform_, rotation);
+}
+
+void Object::SetScale(const Vector& scale)
 {
+  transforms_->SetScale(transform_, scale);
+}
+
+bool Object::SetParent(const Object* parent)
+{
+  if (!transforms_->SetParent(transform_, parent ? parent->transform_ : unsigned(TransformHierarchy::INVALID_HANDLE)))
+    return false;
+  parent_id_ = parent ? parent->id : unsigned(-1);
+  return true;
+}
+
+const float* Object::Model() const
+{
+  return transforms_->World(transform_);
+}
+
+bool Object::UpdateBounds()
+{
+  const Mesh* ready_mesh = mesh && mesh->IsReady() ? mesh : nullptr;
+  unsigned version = transforms_->WorldVersion(transform_);
+  if (ready_mesh == bounds_mesh_ && version == bounds_version_)
+    return false;
+  bounds_version_ = version;
+  bounds_mesh_ = ready_mesh;
+  if (!ready_mesh)
+  {
+    world_bounds_ = Aabb::Empty();
+    return true;
+  }
   
+  glm::mat4 model = glm::make_mat4(Model());
+  
+  // bounding sphere in world space, the longest axis keeps it conservative under any parent scale
+  glm::vec4 world = model * glm::vec4(mesh->bounds_center[0], mesh->bounds_center[1], mesh->bounds_center[2], 1.0f);
+  float max_scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+  world_radius_ = mesh->bounds_radius * max_scale;
+  
+  // the box rotated into world space, each world axis gathers the absolute model axes
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    world_center_[axis] = world[axis];
+    float extent = 0.0f;
+    for (int column = 0; column < 3; ++column)
+      extent += std::fabs(model[column][axis]) * 0.5f * (mesh->bounds_max[column] - mesh->bounds_min[column]);
+    world_bounds_.min[axis] = world[axis] - extent;
+    world_bounds_.max[axis] = world[axis] + extent;
+  }
+  return true;
+}
+
+void Object::Draw(RenderQueue& queue, Shader& shader, const Camera& camera, float projection_scale)
+{
+  if (!mesh || !mesh->IsReady())
+    return;
+  
+  glm::vec3 center(world_center_[0], world_center_[1], world_center_[2]);
+  float distance = glm::length(center - glm::vec3(camera.position.x, camera.position.y, camera.position.z));
+  lod = distance > world_radius_ ? mesh->SelectLod(world_radius_ * projection_scale / distance) : 0;
+  
+  queue.Submit(DrawPacket{mesh, lod, &shader, texture, Model(), opacity, distance / camera.far_plane, 0});
 }
 
 void Object::DrawImGui()
 {
-  ImGui::InputFloat3("Position", &position.x);
-  ImGui::InputFloat3("Rotation", &rotation.x);
-  ImGui::InputFloat3("Scale", &scale.x);
+  static const char* STATE_NAMES[] = {"Loading", "Ready", "Failed"};
+  if (mesh)
+  {
+    ImGui::Text("%s (%s)", mesh->name.c_str(), STATE_NAMES[mesh->state]);
+    if (mesh->IsReady())
+      ImGui::Text("LOD %u of %zu, %u triangles", lod, mesh->lods.size(), mesh->lods[lod].index_count / 3);
+  }
+
+  // edit copies, the setters mark the transform changed
+  Vector position = Position(), rotation = Rotation(), scale = Scale();
+  if (ImGui::InputFloat3("Position", &position.x))
+    SetPosition(position);
+  if (ImGui::InputFloat3("Rotation", &rotation.x))
+    SetRotation(rotation);
+  if (ImGui::InputFloat3("Scale", &scale.x))
+    SetScale(scale);
+  
+  unsigned parent_id = GRAPHICS.FindObject(parent_id_) ? parent_id_ : unsigned(-1);
+  if (ImGui::InputScalar("Parent id", ImGuiDataType_U32, &parent_id, nullptr, nullptr, "%u", ImGuiInputTextFlags_EnterReturnsTrue))
+  {
+    const Object* parent = GRAPHICS.FindObject(parent_id);
+    if (!SetParent(parent))
+    {
+      LOG_MARKED("Object " << id << " cannot be parented to its own descendant " << parent_id, '!');
+    }
+  }
+  ImGui::SliderFloat("Opacity", &opacity, 0.0f, 1.0f);
+  ImGui::Checkbox("Occluder", &occluder);
 }
\ No newline at end of file
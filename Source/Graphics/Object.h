@@ -1,18 +1,102 @@
 #pragma once
 
 #include "../Math/Vector.h"
+#include "../Math/Bvh.h"
 #include "ImGuiDraw.h"
 
+struct Mesh;
+struct Shader;
+struct Texture;
+struct Camera;
+class RenderQueue;
+class TransformHierarchy;
+
 class Object : public ImGuiDraw
 {
   Object();
   public:
-    Object(unsigned id);
+    /*! \brief Creates an Object with a root node in a TransformHierarchy.
+        \param id The handle of this Object in Graphics.
+        \param transforms The hierarchy holding the transform, must outlive the Object.
+    */
+    Object(unsigned id, TransformHierarchy* transforms);
     ~Object();
-    void Draw();
+    
+    //! \return The position relative to the parent.
+    Vector Position() const;
+    //! \return The rotation in radians relative to the parent.
+    Vector Rotation() const;
+    //! \return The scale relative to the parent.
+    Vector Scale() const;
+    //! \return The rotation relative to the parent as a unit quaternion x, y, z, w, cached when SetRotation was called.
+    const float* Orientation() const;
+    
+    //! \brief Sets the position relative to the parent, the model matrix follows on the next TransformHierarchy::Update.
+    void SetPosition(const Vector& position);
+    //! \brief Sets the rotation in radians relative to the parent, applied as in Vector::RotateEulerRad.
+    void SetRotation(const Vector& rotation);
+    //! \brief Sets the scale relative to the parent.
+    void SetScale(const Vector& scale);
+    
+    /*! \brief Moves this Object under another, so it follows that Object's transform.
+        \param parent The new parent, or nullptr to make this Object a root.
+        \return False if the parent is this Object or one of its descendants.
+    */
+    bool SetParent(const Object* parent);
+    
+    //! \return The id of the parent Object as of the last SetParent, may be stale once the parent is deleted.
+    unsigned ParentId() const { return parent_id_; }
+    
+    //! \return The handle of the transform in the TransformHierarchy.
+    unsigned Transform() const { return transform_; }
+    
+    /*! \brief Recomputes the world bounds if the world matrix or mesh changed, call after TransformHierarchy::Update each frame.
+        \return True if WorldBounds changed.
+    */
+    bool UpdateBounds();
+    
+    //! \return The column major model matrix as of the last TransformHierarchy::Update, 16 floats.
+    const float* Model() const;
+    
+    //! \return The world box as of the last UpdateBounds, empty while the mesh is loading.
+    const Aabb& WorldBounds() const { return world_bounds_; }
+    
+    /*! \brief Queues the mesh with the model matrix from UpdateBounds, does nothing while the mesh is loading.
+        
+        The level of detail is picked from the size of the bounding sphere on screen.
+        \param queue The queue drawing this frame.
+        \param shader The shader to draw with, which has per-instance model and opacity attributes.
+        \param camera The camera drawn from, for distance and depth.
+        \param projection_scale Pixels per unit at a distance of one unit, from Camera::ProjectionScale.
+    */
+    void Draw(RenderQueue& queue, Shader& shader, const Camera& camera, float projection_scale);
     void DrawImGui() override;
   
-    Vector position;
-    Vector rotation;
-    Vector scale;
+    //! The handle of this Object in Graphics, stays valid until it is deleted.
+    unsigned id;
+    //! The model drawn, shared with other Objects using the same file.
+    Mesh* mesh;
+    //! Bound while drawing, objects sharing a texture are batched together. May be nullptr.
+    Texture* texture;
+    //! Less than 1 draws blended, sorted back to front.
+    float opacity;
+    //! The level of detail picked by the last Draw.
+    unsigned lod;
+    //! Drawn into the occlusion buffer to hide Objects behind it, best for large solid meshes such as walls.
+    bool occluder;
+  
+  private:
+    //! Holds the local transform and computes the model matrix.
+    TransformHierarchy* transforms_;
+    unsigned transform_;
+    unsigned parent_id_;
+  
+    //! World bounding sphere from the last UpdateBounds.
+    float world_center_[3];
+    float world_radius_;
+    Aabb world_bounds_;
+    //! TransformHierarchy::WorldVersion the bounds were computed from.
+    unsigned bounds_version_;
+    //! The mesh the bounds were computed from, nullptr if it was not ready.
+    const Mesh* bounds_mesh_;
 };
\ No newline at end of file
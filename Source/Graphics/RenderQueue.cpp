@@ -0,0 +1,263 @@
+/*! \file RenderQueue.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of RenderQueue class.
+*/
+
+#include "GL/glew.h"
+#include "RenderQueue.h"
+#include "LowLevel/GLState.h"
+#include "LowLevel/Mesh.h"
+#include "LowLevel/Shader.h"
+#include "LowLevel/Texture.h"
+#include "../Math/RadixSort.h"
+#include "../Threading/ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+
+// HELPER FUNCTIONS START
+
+// key layout from the highest bit down, the state fields total 35 bits
+static const unsigned LAYER_BITS = 4;
+static const unsigned SHADER_BITS = 8;
+static const unsigned TEXTURE_BITS = 10;
+static const unsigned MESH_BITS = 14;
+static const unsigned LOD_BITS = 3;
+static const unsigned DEPTH_BITS = 24;
+
+static const unsigned STATE_BITS = SHADER_BITS + TEXTURE_BITS + MESH_BITS + LOD_BITS;
+static const unsigned TRANSPARENT_SHIFT = STATE_BITS + DEPTH_BITS;
+static const unsigned LAYER_SHIFT = TRANSPARENT_SHIFT + 1;
+static const unsigned long long DEPTH_MAX = (1ull << DEPTH_BITS) - 1;
+
+static_assert(LAYER_SHIFT + LAYER_BITS == 64, "sort key fields must fill 64 bits");
+static_assert((1u << LOD_BITS) >= MeshData::MAX_LODS, "every level of detail needs a distinct key");
+
+static unsigned long long QuantizeDepth(float depth)
+{
+  depth = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+  return static_cast<unsigned long long>(depth * float(DEPTH_MAX));
+}
+
+// HELPER FUNCTIONS END
+
+RenderQueue::RenderQueue() : command_count_(0), instance_buffer_(0), buffer_capacity_(0), white_texture_(0)
+{
+}
+
+void RenderQueue::Initialize()
+{
+  glGenBuffers(1, &instance_buffer_);
+  
+  // one white texel repeated, so untextured draws sample white instead of whatever was bound before
+  const unsigned char WHITE[4] = {255, 255, 255, 255};
+  glGenTextures(1, &white_texture_);
+  GL_STATE.BindTexture(DIFFUSE_TEXTURE_UNIT, white_texture_);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, WHITE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  GL_STATE.BindTexture(DIFFUSE_TEXTURE_UNIT, 0);
+}
+
+void RenderQueue::Exit()
+{
+  if (instance_buffer_)
+    GL_STATE.DeleteBuffer(instance_buffer_);
+  instance_buffer_ = 0;
+  buffer_capacity_ = 0;
+  if (white_texture_)
+    GL_STATE.DeleteTexture(white_texture_);
+  white_texture_ = 0;
+  items_.clear();
+  instances_.clear();
+  keys_.clear();
+  groups_.clear();
+  commands_.clear();
+  command_count_ = 0;
+}
+
+void RenderQueue::Submit(const DrawPacket& packet)
+{
+  bool transparent = packet.opacity < 1.0f;
+  unsigned item = unsigned(items_.size());
+  items_.push_back(Item_{packet.shader, packet.texture, packet.mesh, packet.lod, transparent});
+  
+  instances_.insert(instances_.end(), packet.model, packet.model + 16);
+  instances_.push_back(packet.opacity);
+  
+  unsigned long long state = IdOf_(shader_ids_, packet.shader, (1u << SHADER_BITS) - 1);
+  state = (state << TEXTURE_BITS) | IdOf_(texture_ids_, packet.texture, (1u << TEXTURE_BITS) - 1);
+  state = (state << MESH_BITS) | IdOf_(mesh_ids_, packet.mesh, (1u << MESH_BITS) - 1);
+  state = (state << LOD_BITS) | (packet.lod & ((1u << LOD_BITS) - 1));
+  unsigned long long depth = QuantizeDepth(packet.depth);
+  
+  unsigned long long key = static_cast<unsigned long long>(packet.layer & ((1u << LAYER_BITS) - 1)) << LAYER_SHIFT;
+  if (transparent)
+    // blended draws must go back to front, state only breaks ties
+    key |= (1ull << TRANSPARENT_SHIFT) | ((DEPTH_MAX - depth) << STATE_BITS) | state;
+  else
+    // opaque draws group by state, front to back within a group for early depth rejection
+    key |= (state << DEPTH_BITS) | depth;
+  keys_.push_back(SortEntry_{key, item});
+}
+
+void RenderQueue::Prepare(ThreadPool* pool)
+{
+  stats_ = Stats();
+  stats_.submitted = unsigned(items_.size());
+  command_count_ = 0;
+  if (keys_.empty())
+    return;
+  
+  sort_scratch_.resize(keys_.size());
+  RadixSortByKey(keys_.data(), sort_scratch_.data(), keys_.size());
+  
+  sorted_instances_.resize(instances_.size());
+  auto gather = [this](unsigned begin, unsigned end)
+  {
+    for (size_t i = begin; i < end; ++i)
+      memcpy(&sorted_instances_[i * Mesh::INSTANCE_FLOATS], &instances_[size_t(keys_[i].item) * Mesh::INSTANCE_FLOATS], Mesh::INSTANCE_FLOATS * sizeof(float));
+  };
+  if (pool && keys_.size() >= GATHER_GRAIN_ * 2)
+    pool->ParallelFor(0, unsigned(keys_.size()), GATHER_GRAIN_, gather);
+  else
+    gather(0, unsigned(keys_.size()));
+  
+  groups_.clear();
+  Shader* shader = nullptr;
+  for (unsigned first = 0; first < keys_.size();)
+  {
+    const Item_& item = items_[keys_[first].item];
+    unsigned last = first + 1;
+    while (last < keys_.size() && SameGroup_(item, items_[keys_[last].item]))
+      ++last;
+    groups_.push_back(Group_{first, last - first});
+    
+    if (item.shader != shader)
+    {
+      shader = item.shader;
+      ++stats_.shader_changes;
+    }
+    stats_.transparent += item.transparent ? last - first : 0;
+    first = last;
+  }
+  stats_.draw_calls = unsigned(groups_.size());
+  
+  // each buffer records a share of the groups, Flush replays them in order
+  command_count_ = (unsigned(groups_.size()) + RECORD_GRAIN_ - 1) / RECORD_GRAIN_;
+  if (commands_.size() < command_count_)
+    commands_.resize(command_count_);
+  buffer_triangles_.resize(command_count_);
+  auto record = [this](unsigned begin, unsigned end)
+  {
+    for (unsigned buffer = begin; buffer < end; ++buffer)
+      buffer_triangles_[buffer] = Record_(buffer);
+  };
+  if (pool && command_count_ > 1)
+    pool->ParallelFor(0, command_count_, 1, record);
+  else
+    record(0, command_count_);
+  
+  for (unsigned buffer = 0; buffer < command_count_; ++buffer)
+  {
+    stats_.triangles += buffer_triangles_[buffer];
+    stats_.commands += commands_[buffer].Count();
+    stats_.command_bytes += commands_[buffer].Bytes();
+  }
+}
+
+void RenderQueue::Flush()
+{
+  if (command_count_)
+  {
+    Upload_(sorted_instances_.size() * sizeof(float));
+    for (unsigned buffer = 0; buffer < command_count_; ++buffer)
+      commands_[buffer].Replay();
+    GL_STATE.DepthMask(true);
+    GL_STATE.BindVertexArray(0);
+  }
+  
+  command_count_ = 0;
+  items_.clear();
+  instances_.clear();
+  keys_.clear();
+}
+
+void RenderQueue::Dump(std::ostream& out) const
+{
+  out << stats_.commands << " commands, " << stats_.command_bytes << " bytes in " << command_count_ << " buffers\n";
+  for (unsigned op = 0; op < CommandBuffer::OP_COUNT; ++op)
+  {
+    unsigned count = 0;
+    for (unsigned buffer = 0; buffer < command_count_; ++buffer)
+      count += commands_[buffer].Count(CommandBuffer::Op(op));
+    out << CommandBuffer::OP_NAMES[op] << ": " << count << '\n';
+  }
+  
+  for (unsigned buffer = 0; buffer < command_count_; ++buffer)
+  {
+    out << "\n# buffer " << buffer << '\n';
+    commands_[buffer].Dump(out);
+  }
+}
+
+unsigned RenderQueue::IdOf_(IdTable_& table, const void* pointer, unsigned mask)
+{
+  if (!pointer)
+    return 0;
+  // consecutive packets usually share state, skip the hash lookup for them
+  if (pointer == table.last)
+    return table.last_id;
+  
+  auto found = table.ids.find(pointer);
+  if (found == table.ids.end())
+    found = table.ids.emplace(pointer, unsigned(table.ids.size() + 1) & mask).first;
+  table.last = pointer;
+  table.last_id = found->second;
+  return found->second;
+}
+
+bool RenderQueue::SameGroup_(const Item_& a, const Item_& b)
+{
+  return a.shader == b.shader && a.texture == b.texture && a.mesh == b.mesh && a.lod == b.lod && a.transparent == b.transparent;
+}
+
+unsigned RenderQueue::Record_(unsigned buffer)
+{
+  CommandBuffer& commands = commands_[buffer];
+  commands.Clear();
+  
+  // every buffer starts from unknown state, replaying through GL_STATE skips what the previous one left set
+  unsigned triangles = 0;
+  const Item_* previous = nullptr;
+  unsigned end = std::min(unsigned(groups_.size()), (buffer + 1) * RECORD_GRAIN_);
+  for (unsigned group = buffer * RECORD_GRAIN_; group < end; ++group)
+  {
+    const Group_& run = groups_[group];
+    const Item_& item = items_[keys_[run.first].item];
+    if (!previous || item.shader != previous->shader)
+      commands.UseProgram(item.shader->program);
+    if (!previous || item.texture != previous->texture)
+      commands.BindTexture(DIFFUSE_TEXTURE_UNIT, item.texture ? item.texture->id : white_texture_);
+    // blended draws test against opaque depth but must not hide each other
+    if (!previous || item.transparent != previous->transparent)
+      commands.DepthMask(!item.transparent);
+    
+    triangles += item.mesh->Record(commands, item.lod, run.count, size_t(run.first) * Mesh::INSTANCE_FLOATS * sizeof(float)) * run.count;
+    previous = &item;
+  }
+  return triangles;
+}
+
+void RenderQueue::Upload_(size_t bytes)
+{
+  GL_STATE.BindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+  if (bytes > buffer_capacity_)
+    buffer_capacity_ = std::max(bytes, buffer_capacity_ * 2);
+  // orphan last frame's storage so the driver need not wait for draws still reading it
+  glBufferData(GL_ARRAY_BUFFER, buffer_capacity_, nullptr, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, sorted_instances_.data());
+}
@@ -0,0 +1,197 @@
+/*! \file RenderQueue.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains RenderQueue class, which sorts draw packets by a 64-bit key and batches them into instanced draws.
+*/
+
+#pragma once
+
+#include "LowLevel/CommandBuffer.h"
+
+#include <cstddef>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+class ThreadPool;
+
+typedef unsigned int	GLuint;
+struct Mesh;
+struct Shader;
+struct Texture;
+
+//! Everything RenderQueue needs to draw one instance of a mesh.
+struct DrawPacket
+{
+  Mesh* mesh;
+  //! The level of detail of the mesh.
+  unsigned lod;
+  Shader* shader;
+  //! Bound while drawing, the queue binds a white texture if nullptr.
+  Texture* texture;
+  //! The column major model matrix, 16 floats, copied by Submit.
+  const float* model;
+  //! Less than 1 draws blended, back to front after every opaque packet of the layer.
+  float opacity;
+  //! Distance from the eye, 0 at the eye and 1 at the far plane.
+  float depth;
+  //! Lower layers, such as viewports, draw first.
+  unsigned layer;
+};
+
+/*! Collects every draw of a frame as packets and issues one
+    glDrawElementsInstanced per run of packets sharing a shader, texture,
+    mesh, and level of detail.
+
+    Each packet gets a 64-bit key, high bits first: layer, opaque or
+    transparent, then for opaque packets shader, texture, mesh, level of
+    detail, and depth front to back, and for transparent ones depth back to
+    front followed by the same state. One radix sort then gives both the
+    fewest state changes and correct blending order.
+
+    The per-instance data of a run is packed next to each other in a single
+    instance buffer that is uploaded once per Flush, see Mesh::INSTANCE_FLOATS.
+    
+    Prepare records the draws of the runs into command buffers, split across
+    workers, so Flush on the GL thread only uploads and replays them in order.
+*/
+class RenderQueue
+{
+  public:
+    //! Counts of the last Prepare.
+    struct Stats
+    {
+      //! Draws submitted.
+      unsigned submitted = 0;
+      //! Of which were transparent.
+      unsigned transparent = 0;
+      //! Instanced draw calls issued.
+      unsigned draw_calls = 0;
+      //! Shader changes, a program switch each.
+      unsigned shader_changes = 0;
+      //! Triangles drawn over every instance.
+      unsigned triangles = 0;
+      //! GL commands recorded, and their size.
+      unsigned commands = 0;
+      size_t command_bytes = 0;
+      
+      //! \return The draw calls a draw per submission would have cost on top.
+      unsigned DrawCallsSaved() const { return submitted - draw_calls; }
+    };
+  
+    RenderQueue();
+    
+    //! \brief Creates the instance buffer and the white texture, must be called on the GL thread.
+    void Initialize();
+    
+    //! \brief Deletes the instance buffer and the white texture, must be called on the GL thread.
+    void Exit();
+    
+    /*! \brief Queues a draw until the next Flush.
+        \param packet The draw, its mesh must be Ready.
+    */
+    void Submit(const DrawPacket& packet);
+    
+    /*! \brief Sorts the queued packets, gathers their instance data, and records their draws, makes no GL calls.
+        \param pool Workers to gather instance data and record on, may be nullptr.
+    */
+    void Prepare(ThreadPool* pool = nullptr);
+    
+    //! \brief Draws and clears every queued packet, must be called on the GL thread after Prepare.
+    void Flush();
+    
+    /*! \brief Writes the commands recorded by the last Prepare, one per line, after counts of each kind.
+        \param out The stream to write to, call before Flush.
+    */
+    void Dump(std::ostream& out) const;
+    
+    //! \return The counts of the last Prepare.
+    const Stats& LastStats() const { return stats_; }
+  
+  private:
+    //! Instances copied per task when Prepare is given workers.
+    static const unsigned GATHER_GRAIN_ = 8192;
+    //! Instanced draws recorded per command buffer.
+    static const unsigned RECORD_GRAIN_ = 512;
+    
+    //! A queued packet, its instance data lives in instances_.
+    struct Item_
+    {
+      Shader* shader;
+      Texture* texture;
+      Mesh* mesh;
+      unsigned lod;
+      bool transparent;
+    };
+    
+    //! A run of sorted packets drawn as one instanced draw.
+    struct Group_
+    {
+      unsigned first;
+      unsigned count;
+    };
+    
+    //! Sorted in place of the items, so the sort moves 16 bytes per packet.
+    struct SortEntry_
+    {
+      unsigned long long key;
+      unsigned item;
+    };
+    
+    //! Small ids given to pointers for the key, stable for the life of the queue.
+    struct IdTable_
+    {
+      std::unordered_map<const void*, unsigned> ids;
+      const void* last = nullptr;
+      unsigned last_id = 0;
+    };
+  
+    /*! \brief Returns the id of a pointer, assigning the next one if it is new.
+        \param table The table for this kind of pointer.
+        \param pointer The pointer, nullptr is always 0.
+        \param mask Ids wrap within this mask, a collision only costs batching.
+        \return The id.
+    */
+    static unsigned IdOf_(IdTable_& table, const void* pointer, unsigned mask);
+  
+    //! \return True if a and b can share an instanced draw.
+    static bool SameGroup_(const Item_& a, const Item_& b);
+    
+    /*! \brief Records the draws of one command buffer's share of groups_.
+        \param buffer The index of the command buffer.
+        \return The triangles drawn over every instance.
+    */
+    unsigned Record_(unsigned buffer);
+    
+    /*! \brief Uploads the sorted instance data, growing the buffer if needed.
+        \param bytes The size of the sorted instance data.
+    */
+    void Upload_(size_t bytes);
+  
+    //! Packets in submission order, capacity is kept between frames.
+    std::vector<Item_> items_;
+    //! Instance data in submission order.
+    std::vector<float> instances_;
+    //! Instance data in draw order, as uploaded.
+    std::vector<float> sorted_instances_;
+    std::vector<SortEntry_> keys_;
+    std::vector<SortEntry_> sort_scratch_;
+    std::vector<Group_> groups_;
+    //! Command buffers of the last Prepare, kept between frames so recording reuses their storage.
+    std::vector<CommandBuffer> commands_;
+    //! Command buffers in use, the rest are spare.
+    unsigned command_count_;
+    //! Triangles each command buffer draws, summed into stats_.
+    std::vector<unsigned> buffer_triangles_;
+    
+    IdTable_ shader_ids_;
+    IdTable_ texture_ids_;
+    IdTable_ mesh_ids_;
+    
+    GLuint instance_buffer_;
+    //! Size of instance_buffer_ in bytes.
+    size_t buffer_capacity_;
+    //! Bound for packets without a texture.
+    GLuint white_texture_;
+    Stats stats_;
+};
@@ -0,0 +1,170 @@
+/*! \file RenderThread.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of ImGuiDrawCopy and RenderThread.
+*/
+
+#include "RenderThread.h"
+
+#include "GLFW/glfw3.h"
+
+#include <cstring>
+
+// HELPER FUNCTIONS START
+
+//! Weight of the newest frame in the smoothed timings.
+static const float SMOOTHING = 0.1f;
+
+//! Copies an ImVector of plain data without freeing its storage when it shrinks.
+template <typename T>
+static void CopyVector(ImVector<T>& to, const ImVector<T>& from)
+{
+  to.resize(from.Size);
+  if (from.Size)
+    memcpy(to.Data, from.Data, size_t(from.Size) * sizeof(T));
+}
+
+//! \return The smoothed value moved toward a new sample.
+static float Smooth(float smoothed, float sample)
+{
+  return smoothed == 0.0f ? sample : smoothed + (sample - smoothed) * SMOOTHING;
+}
+
+//! \return Milliseconds from start to end.
+static float Milliseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+  return std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+// HELPER FUNCTIONS END
+
+ImGuiDrawCopy::ImGuiDrawCopy()
+{
+}
+
+ImGuiDrawCopy::~ImGuiDrawCopy()
+{
+  for (ImDrawList* list : lists_)
+    IM_DELETE(list);
+}
+
+void ImGuiDrawCopy::Copy(const ImDrawData& source)
+{
+  // the copies are only drawn, they never need ImGui's shared data
+  while (lists_.size() < size_t(source.CmdListsCount))
+    lists_.push_back(IM_NEW(ImDrawList)(nullptr));
+
+  for (int i = 0; i < source.CmdListsCount; ++i)
+  {
+    const ImDrawList& from = *source.CmdLists[i];
+    ImDrawList& to = *lists_[i];
+    CopyVector(to.CmdBuffer, from.CmdBuffer);
+    CopyVector(to.IdxBuffer, from.IdxBuffer);
+    CopyVector(to.VtxBuffer, from.VtxBuffer);
+    to.Flags = from.Flags;
+  }
+
+  data_ = source;
+  data_.CmdLists = lists_.empty() ? nullptr : lists_.data();
+}
+
+RenderThread::RenderThread() : window_(nullptr), published_(0), completed_(0), stopping_(false), next_frame_(1), frame_wait_ms_(0.0f)
+{
+}
+
+void RenderThread::Start(GLFWwindow* window, std::function<void(FrameSnapshot&)> render)
+{
+  window_ = window;
+  render_ = std::move(render);
+  stopping_ = false;
+  thread_ = std::thread(&RenderThread::Loop_, this);
+}
+
+void RenderThread::Stop()
+{
+  if (!thread_.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  changed_.notify_all();
+  thread_.join();
+}
+
+FrameSnapshot& RenderThread::Acquire()
+{
+  unsigned long long frame = next_frame_;
+  FrameSnapshot& snapshot = snapshots_[frame % SNAPSHOTS];
+
+  // the frame this snapshot last carried must have been drawn
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this, frame]() { return completed_ + SNAPSHOTS >= frame; });
+  }
+  frame_wait_ms_ += Milliseconds(start, std::chrono::steady_clock::now());
+
+  // frames complete in order, so this is the next present after the last one measured
+  if (snapshot.frame)
+  {
+    stats_.render_ms = Smooth(stats_.render_ms, snapshot.render_ms);
+    stats_.latency_ms = Smooth(stats_.latency_ms, Milliseconds(snapshot.input_time, snapshot.presented_time));
+    if (snapshot.frame > 1)
+      stats_.frame_ms = Smooth(stats_.frame_ms, Milliseconds(last_presented_, snapshot.presented_time));
+    last_presented_ = snapshot.presented_time;
+  }
+  stats_.wait_ms = Smooth(stats_.wait_ms, frame_wait_ms_);
+  frame_wait_ms_ = 0.0f;
+  return snapshot;
+}
+
+void RenderThread::Publish(bool pipelined)
+{
+  unsigned long long frame = next_frame_++;
+  snapshots_[frame % SNAPSHOTS].frame = frame;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    published_ = frame;
+  }
+  changed_.notify_all();
+  if (pipelined)
+    return;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this, frame]() { return completed_ >= frame; });
+  }
+  frame_wait_ms_ += Milliseconds(start, std::chrono::steady_clock::now());
+}
+
+void RenderThread::Loop_()
+{
+  glfwMakeContextCurrent(window_);
+  for (;;)
+  {
+    unsigned long long frame;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      changed_.wait(lock, [this]() { return stopping_ || published_ > completed_; });
+      // published frames are drawn before stopping
+      if (published_ == completed_)
+        break;
+      frame = completed_ + 1;
+    }
+
+    FrameSnapshot& snapshot = snapshots_[frame % SNAPSHOTS];
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    render_(snapshot);
+    snapshot.presented_time = std::chrono::steady_clock::now();
+    snapshot.render_ms = Milliseconds(start, snapshot.presented_time);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completed_ = frame;
+    }
+    changed_.notify_all();
+  }
+  glfwMakeContextCurrent(nullptr);
+}
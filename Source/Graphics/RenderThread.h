@@ -0,0 +1,149 @@
+/*! \file RenderThread.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains FrameSnapshot, everything one frame draws, and RenderThread, the thread owning the GL context that draws them.
+*/
+
+#pragma once
+
+#include "RenderQueue.h"
+#include "LowLevel/FrameUniforms.h"
+#include "LowLevel/GLState.h"
+#include "Model/ModelLoader.h"
+#include "ImGui/imgui.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct GLFWwindow;
+
+/*! A copy of ImGui's draw data that stays valid through the next NewFrame.
+
+    The draw lists are kept between frames, so once their buffers have grown
+    a copy is only memcpy.
+*/
+class ImGuiDrawCopy
+{
+  public:
+    ImGuiDrawCopy();
+    ~ImGuiDrawCopy();
+
+    ImGuiDrawCopy(const ImGuiDrawCopy&) = delete;
+    ImGuiDrawCopy& operator=(const ImGuiDrawCopy&) = delete;
+
+    //! \param source Draw data from ImGui::Render, copied.
+    void Copy(const ImDrawData& source);
+
+    //! \return The copy, for ImGui_ImplOpenGL3_RenderDrawData.
+    ImDrawData* Data() { return &data_; }
+
+  private:
+    ImDrawData data_;
+    std::vector<ImDrawList*> lists_;
+};
+
+//! Everything needed to draw one frame, filled by the update thread and only read by the render thread.
+struct FrameSnapshot
+{
+  //! The frame number, from 1.
+  unsigned long long frame = 0;
+  //! Packets of the visible Objects, sorted by Prepare.
+  RenderQueue queue;
+  FrameUniforms uniforms;
+  int display_width = 0;
+  int display_height = 0;
+  ImGuiDrawCopy imgui;
+  //! When the input drawn by this frame was polled.
+  std::chrono::steady_clock::time_point input_time;
+
+  // written by the render thread, read back once the snapshot is acquired again
+  //! Meshes uploaded while drawing the frame, for ModelLoader::Publish.
+  std::vector<ModelLoader::Uploaded> uploaded;
+  RenderQueue::Stats draw_stats;
+  GLState::Counters gl_calls;
+  float render_ms = 0.0f;
+  //! When the buffers were swapped.
+  std::chrono::steady_clock::time_point presented_time;
+};
+
+/*! A thread owning the GL context, drawing the frames the update thread
+    publishes.
+
+    There are two snapshots. While the render thread draws frame N from one,
+    the update thread simulates frame N+1 into the other, waiting in Acquire
+    only if it gets two frames ahead. Without pipelining Publish waits for
+    the frame to be drawn, as when both ran on one thread, so the two can be
+    compared.
+*/
+class RenderThread
+{
+  public:
+    //! Frames in flight at most, one updating and one drawing.
+    static const unsigned SNAPSHOTS = 2;
+
+    //! Times in milliseconds, smoothed over recent frames.
+    struct Stats
+    {
+      //! Drawing a frame on the render thread.
+      float render_ms = 0.0f;
+      //! The update thread blocked in Acquire and Publish.
+      float wait_ms = 0.0f;
+      //! From polling input to presenting the frame showing it.
+      float latency_ms = 0.0f;
+      //! Between presents, the inverse of throughput.
+      float frame_ms = 0.0f;
+    };
+
+    RenderThread();
+
+    /*! \brief Starts the thread, the context must not be current on the calling thread.
+        \param window The window whose context the thread makes current.
+        \param render Draws a snapshot, called on the render thread.
+    */
+    void Start(GLFWwindow* window, std::function<void(FrameSnapshot&)> render);
+
+    //! \brief Draws every published frame, then joins the thread, which releases the context.
+    void Stop();
+
+    //! \return A snapshot by index, to initialize or free its GL resources while the thread is stopped.
+    FrameSnapshot& Snapshot(unsigned index) { return snapshots_[index]; }
+
+    /*! \brief Returns the snapshot to fill for the next frame, waiting until it has been drawn.
+        \return The snapshot, holding the results of the frame it last carried.
+    */
+    FrameSnapshot& Acquire();
+
+    /*! \brief Hands the acquired snapshot to the render thread.
+        \param pipelined False waits until it has been drawn.
+    */
+    void Publish(bool pipelined);
+
+    //! \return Timings of recent frames.
+    const Stats& GetStats() const { return stats_; }
+
+  private:
+    //! \brief Loop run by the thread.
+    void Loop_();
+
+    FrameSnapshot snapshots_[SNAPSHOTS];
+    std::thread thread_;
+    GLFWwindow* window_;
+    std::function<void(FrameSnapshot&)> render_;
+
+    //! Guarded by mutex_, the last frame published and the last frame drawn.
+    unsigned long long published_;
+    unsigned long long completed_;
+    bool stopping_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+
+    //! Only used by the update thread.
+    unsigned long long next_frame_;
+    std::chrono::steady_clock::time_point last_presented_;
+    float frame_wait_ms_;
+    Stats stats_;
+};
@@ -0,0 +1,288 @@
+/*! \file TransformHierarchy.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of TransformHierarchy.
+*/
+
+#include "TransformHierarchy.h"
+#include "../Threading/ThreadPool.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+TransformHierarchy::TransformHierarchy() : level_starts_(1, 0), order_dirty_(false), update_count_(0)
+{
+}
+
+unsigned TransformHierarchy::Create()
+{
+  unsigned handle;
+  if (!free_handles_.empty())
+  {
+    handle = free_handles_.back();
+    free_handles_.pop_back();
+  }
+  else
+  {
+    handle = unsigned(index_of_.size());
+    index_of_.push_back(0);
+  }
+
+  index_of_[handle] = unsigned(nodes_.size());
+  nodes_.push_back(Node_{handle, INVALID_HANDLE, INVALID_HANDLE, 0});
+  locals_.push_back(Local_{{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f}});
+  Matrix_ identity;
+  memcpy(identity.m, glm::value_ptr(glm::mat4(1.0f)), sizeof(identity.m));
+  worlds_.push_back(identity);
+  changed_.push_back(1);
+  // a root at the end is out of order once deeper nodes exist
+  order_dirty_ = true;
+  return handle;
+}
+
+void TransformHierarchy::Destroy(unsigned handle)
+{
+  if (handle >= index_of_.size() || index_of_[handle] == INVALID_HANDLE)
+    return;
+
+  // swap the last node into the hole, the sort in the next Update restores depth order
+  unsigned index = index_of_[handle], last = unsigned(nodes_.size() - 1);
+  if (index != last)
+  {
+    nodes_[index] = nodes_[last];
+    locals_[index] = locals_[last];
+    worlds_[index] = worlds_[last];
+    changed_[index] = changed_[last];
+    index_of_[nodes_[index].handle] = index;
+  }
+  nodes_.pop_back();
+  locals_.pop_back();
+  worlds_.pop_back();
+  changed_.pop_back();
+  index_of_[handle] = INVALID_HANDLE;
+  destroyed_handles_.push_back(handle);
+  order_dirty_ = true;
+}
+
+bool TransformHierarchy::SetParent(unsigned handle, unsigned parent)
+{
+  // walking up from the parent must not reach the node, a destroyed ancestor ends the walk as its children become roots
+  for (unsigned ancestor = parent; ancestor != INVALID_HANDLE && index_of_[ancestor] != INVALID_HANDLE; ancestor = nodes_[index_of_[ancestor]].parent)
+    if (ancestor == handle)
+      return false;
+
+  Node_& node = nodes_[index_of_[handle]];
+  if (node.parent == parent)
+    return true;
+  node.parent = parent;
+  order_dirty_ = true;
+  Touch_(handle);
+  return true;
+}
+
+unsigned TransformHierarchy::Parent(unsigned handle) const
+{
+  return nodes_[index_of_[handle]].parent;
+}
+
+void TransformHierarchy::SetPosition(unsigned handle, const Vector& position)
+{
+  float* value = locals_[index_of_[handle]].position;
+  value[0] = position.x;
+  value[1] = position.y;
+  value[2] = position.z;
+  Touch_(handle);
+}
+
+void TransformHierarchy::SetRotation(unsigned handle, const Vector& rotation)
+{
+  Local_& local = locals_[index_of_[handle]];
+  local.rotation[0] = rotation.x;
+  local.rotation[1] = rotation.y;
+  local.rotation[2] = rotation.z;
+  
+  // same order as Vector::RotateEulerRad, y then z then x
+  glm::quat orientation = glm::angleAxis(rotation.x, glm::vec3(1.0f, 0.0f, 0.0f)) *
+                          glm::angleAxis(rotation.z, glm::vec3(0.0f, 0.0f, 1.0f)) *
+                          glm::angleAxis(rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+  local.orientation[0] = orientation.x;
+  local.orientation[1] = orientation.y;
+  local.orientation[2] = orientation.z;
+  local.orientation[3] = orientation.w;
+  Touch_(handle);
+}
+
+void TransformHierarchy::SetScale(unsigned handle, const Vector& scale)
+{
+  float* value = locals_[index_of_[handle]].scale;
+  value[0] = scale.x;
+  value[1] = scale.y;
+  value[2] = scale.z;
+  Touch_(handle);
+}
+
+Vector TransformHierarchy::Position(unsigned handle) const
+{
+  const float* value = locals_[index_of_[handle]].position;
+  return Vector(value[0], value[1], value[2]);
+}
+
+Vector TransformHierarchy::Rotation(unsigned handle) const
+{
+  const float* value = locals_[index_of_[handle]].rotation;
+  return Vector(value[0], value[1], value[2]);
+}
+
+Vector TransformHierarchy::Scale(unsigned handle) const
+{
+  const float* value = locals_[index_of_[handle]].scale;
+  return Vector(value[0], value[1], value[2]);
+}
+
+const float* TransformHierarchy::Orientation(unsigned handle) const
+{
+  return locals_[index_of_[handle]].orientation;
+}
+
+void TransformHierarchy::Touch_(unsigned handle)
+{
+  changed_[index_of_[handle]] = 1;
+}
+
+void TransformHierarchy::Update(ThreadPool* pool)
+{
+  stats_ = Stats();
+  stats_.reordered = order_dirty_;
+  if (order_dirty_)
+    Reorder_();
+  ++update_count_;
+  stats_.levels = unsigned(level_starts_.size() - 1);
+
+  // parents are a depth above, so finishing each depth before the next is all the ordering needed
+  for (unsigned level = 0; level < stats_.levels; ++level)
+  {
+    unsigned begin = level_starts_[level], end = level_starts_[level + 1];
+    if (!pool || end - begin < PARALLEL_CHUNK * 2)
+    {
+      stats_.recomputed += UpdateRange_(begin, end);
+      continue;
+    }
+
+    std::atomic<unsigned> recomputed(0);
+    pool->ParallelFor(begin, end, PARALLEL_CHUNK, [this, &recomputed](unsigned chunk, unsigned chunk_end) { recomputed += UpdateRange_(chunk, chunk_end); });
+    stats_.recomputed += recomputed;
+  }
+
+  std::fill(changed_.begin(), changed_.end(), (unsigned char)0);
+}
+
+unsigned TransformHierarchy::UpdateRange_(unsigned begin, unsigned end)
+{
+  unsigned recomputed = 0;
+  for (unsigned i = begin; i < end; ++i)
+  {
+    unsigned parent = nodes_[i].parent_index;
+    if (!changed_[i] && (parent == INVALID_HANDLE || !changed_[parent]))
+      continue;
+
+    // translation * rotation * scale, written directly rather than multiplied
+    const Local_& local = locals_[i];
+    glm::quat orientation(local.orientation[3], local.orientation[0], local.orientation[1], local.orientation[2]);
+    glm::mat3 rotation = glm::mat3_cast(orientation);
+    glm::mat4 matrix(1.0f);
+    for (int column = 0; column < 3; ++column)
+    {
+      matrix[column] = glm::vec4(rotation[column] * local.scale[column], 0.0f);
+      matrix[3][column] = local.position[column];
+    }
+    if (parent != INVALID_HANDLE)
+      matrix = glm::make_mat4(worlds_[parent].m) * matrix;
+
+    memcpy(worlds_[i].m, glm::value_ptr(matrix), sizeof(worlds_[i].m));
+    nodes_[i].version = update_count_;
+    // children a depth below see this and recompute too
+    changed_[i] = 1;
+    ++recomputed;
+  }
+  return recomputed;
+}
+
+void TransformHierarchy::Reorder_()
+{
+  // children of destroyed nodes become roots, their world matrix changes
+  for (unsigned i = 0; i < nodes_.size(); ++i)
+    if (nodes_[i].parent != INVALID_HANDLE && index_of_[nodes_[i].parent] == INVALID_HANDLE)
+    {
+      nodes_[i].parent = INVALID_HANDLE;
+      changed_[i] = 1;
+    }
+  free_handles_.insert(free_handles_.end(), destroyed_handles_.begin(), destroyed_handles_.end());
+  destroyed_handles_.clear();
+
+  // depth of every node, walking up only until a known depth is found
+  std::vector<unsigned> depths(nodes_.size(), unsigned(INVALID_HANDLE)), path;
+  unsigned max_depth = 0;
+  for (unsigned i = 0; i < nodes_.size(); ++i)
+  {
+    unsigned index = i;
+    while (depths[index] == INVALID_HANDLE && nodes_[index].parent != INVALID_HANDLE)
+    {
+      path.push_back(index);
+      index = index_of_[nodes_[index].parent];
+    }
+    unsigned depth = depths[index] == INVALID_HANDLE ? 0 : depths[index];
+    depths[index] = depth;
+    while (!path.empty())
+    {
+      depths[path.back()] = ++depth;
+      path.pop_back();
+    }
+    max_depth = std::max(max_depth, depths[i]);
+  }
+
+  // counting sort by depth, stable so siblings keep their relative order
+  level_starts_.assign(max_depth + 2, 0);
+  for (unsigned depth : depths)
+    ++level_starts_[depth + 1];
+  for (unsigned level = 1; level < level_starts_.size(); ++level)
+    level_starts_[level] += level_starts_[level - 1];
+
+  std::vector<unsigned> next(level_starts_.begin(), level_starts_.end() - 1);
+  std::vector<Node_> nodes(nodes_.size());
+  std::vector<Local_> locals(nodes_.size());
+  std::vector<Matrix_> worlds(nodes_.size());
+  std::vector<unsigned char> changed(nodes_.size());
+  for (unsigned i = 0; i < nodes_.size(); ++i)
+  {
+    unsigned index = next[depths[i]]++;
+    nodes[index] = nodes_[i];
+    locals[index] = locals_[i];
+    worlds[index] = worlds_[i];
+    changed[index] = changed_[i];
+  }
+  nodes_.swap(nodes);
+  locals_.swap(locals);
+  worlds_.swap(worlds);
+  changed_.swap(changed);
+
+  for (unsigned i = 0; i < nodes_.size(); ++i)
+    index_of_[nodes_[i].handle] = i;
+  for (Node_& node : nodes_)
+    node.parent_index = node.parent == INVALID_HANDLE ? INVALID_HANDLE : index_of_[node.parent];
+  order_dirty_ = false;
+}
+
+const float* TransformHierarchy::World(unsigned handle) const
+{
+  return worlds_[index_of_[handle]].m;
+}
+
+unsigned TransformHierarchy::WorldVersion(unsigned handle) const
+{
+  return nodes_[index_of_[handle]].version;
+}
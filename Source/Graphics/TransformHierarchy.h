@@ -0,0 +1,159 @@
+/*! \file TransformHierarchy.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains TransformHierarchy class, parent/child transforms whose world matrices are updated lazily.
+*/
+
+#pragma once
+
+#include "../Math/Vector.h"
+
+#include <vector>
+
+class ThreadPool;
+
+/*! Local position, rotation, and scale of many nodes, each optionally the
+    child of another, and the world matrices they produce.
+
+    Setting a local value only marks the node. Update then recomputes the
+    marked nodes and everything below them, and nothing else. Nodes are
+    stored in contiguous arrays sorted by depth, so every parent comes
+    before its children. That makes the update one linear pass, with each
+    depth split across workers when it is large.
+
+    Handles stay valid until Destroy. The sort runs inside Update, and only
+    after the tree's structure has changed.
+*/
+class TransformHierarchy
+{
+  public:
+    //! A handle Create never returns, also meaning no parent.
+    static const unsigned INVALID_HANDLE = ~0u;
+    //! Depths with fewer nodes than this are updated on the calling thread, and larger ones in chunks of this size.
+    static const unsigned PARALLEL_CHUNK = 4096;
+
+    //! Counts of the last Update.
+    struct Stats
+    {
+      //! World matrices recomputed.
+      unsigned recomputed = 0;
+      //! Depth of the deepest node plus one.
+      unsigned levels = 0;
+      //! True if the arrays were sorted again because parents changed.
+      bool reordered = false;
+    };
+
+    TransformHierarchy();
+
+    /*! \brief Adds a root node with an identity transform.
+        \return The handle of the node.
+    */
+    unsigned Create();
+
+    /*! \brief Removes a node, its children become roots keeping their local transforms.
+        \param handle The node, stale handles are ignored.
+    */
+    void Destroy(unsigned handle);
+
+    /*! \brief Attaches a node to a parent, keeping its local transform.
+        \param handle The node.
+        \param parent The new parent, or INVALID_HANDLE to make the node a root.
+        \return False if the parent is the node or one of its descendants.
+    */
+    bool SetParent(unsigned handle, unsigned parent);
+
+    //! \return The parent of a node, INVALID_HANDLE for roots.
+    unsigned Parent(unsigned handle) const;
+
+    //! \brief Sets the position relative to the parent.
+    void SetPosition(unsigned handle, const Vector& position);
+    //! \brief Sets the rotation in radians relative to the parent, applied as in Vector::RotateEulerRad.
+    void SetRotation(unsigned handle, const Vector& rotation);
+    //! \brief Sets the scale relative to the parent.
+    void SetScale(unsigned handle, const Vector& scale);
+
+    //! \return The position relative to the parent.
+    Vector Position(unsigned handle) const;
+    //! \return The rotation in radians relative to the parent.
+    Vector Rotation(unsigned handle) const;
+    //! \return The scale relative to the parent.
+    Vector Scale(unsigned handle) const;
+
+    //! \return The rotation relative to the parent as a unit quaternion x, y, z, w, converted when it was set.
+    const float* Orientation(unsigned handle) const;
+
+    /*! \brief Sorts the arrays if the structure changed, then recomputes the world
+               matrices of changed nodes and their descendants.
+        \param pool Workers to split large depths across, may be nullptr.
+    */
+    void Update(ThreadPool* pool);
+
+    //! \return The column major world matrix as of the last Update, 16 floats.
+    const float* World(unsigned handle) const;
+
+    //! \return A number that changes whenever Update recomputes the world matrix.
+    unsigned WorldVersion(unsigned handle) const;
+
+    //! \return The number of nodes.
+    unsigned Size() const { return unsigned(nodes_.size()); }
+
+    //! \return Counts of the last Update.
+    const Stats& LastStats() const { return stats_; }
+
+  private:
+    struct Node_
+    {
+      unsigned handle;
+      //! Handle of the parent, kept across sorts.
+      unsigned parent;
+      //! Index of the parent in the arrays, valid while order_dirty_ is false.
+      unsigned parent_index;
+      //! The Update that last recomputed the world matrix.
+      unsigned version;
+    };
+
+    //! Position, rotation, and scale relative to the parent.
+    struct Local_
+    {
+      float position[3];
+      //! Euler angles as set, kept for editing.
+      float rotation[3];
+      float scale[3];
+      //! The same rotation as a quaternion x, y, z, w, so Update needs no sin or cos.
+      float orientation[4];
+    };
+
+    struct Matrix_
+    {
+      float m[16];
+    };
+
+    //! \brief Marks a node changed so Update recomputes it and its descendants.
+    void Touch_(unsigned handle);
+
+    //! \brief Sorts every array by depth, detaching children of destroyed nodes.
+    void Reorder_();
+
+    //! \brief Recomputes the changed nodes in a range of one depth.
+    unsigned UpdateRange_(unsigned begin, unsigned end);
+
+    //! Each array is indexed by position in depth order.
+    std::vector<Node_> nodes_;
+    std::vector<Local_> locals_;
+    std::vector<Matrix_> worlds_;
+    //! 1 if the node or an ancestor changed since the last Update.
+    std::vector<unsigned char> changed_;
+
+    //! Position in the arrays of each handle, INVALID_HANDLE if destroyed.
+    std::vector<unsigned> index_of_;
+    //! Handles free for Create.
+    std::vector<unsigned> free_handles_;
+    //! Handles destroyed since the last sort, reused only after it so children can tell their parent is gone.
+    std::vector<unsigned> destroyed_handles_;
+    //! First index of each depth, followed by the end; just {0} before the first sort.
+    std::vector<unsigned> level_starts_;
+
+    bool order_dirty_;
+    unsigned update_count_;
+    Stats stats_;
+};
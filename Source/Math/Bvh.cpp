@@ -0,0 +1,632 @@
+/*! \file Bvh.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of Aabb and Bvh.
+*/
+
+#include "Bvh.h"
+#include "Culling.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+Aabb Aabb::Empty()
+{
+  return Aabb{{FLT_MAX, FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+}
+
+void Aabb::Expand(const Aabb& other)
+{
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    min[axis] = std::min(min[axis], other.min[axis]);
+    max[axis] = std::max(max[axis], other.max[axis]);
+  }
+}
+
+float Aabb::HalfArea() const
+{
+  if (IsEmpty())
+    return 0.0f;
+  float x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+  return x * y + y * z + z * x;
+}
+
+// HELPER FUNCTIONS START
+
+enum PlaneResult_ { Outside, Intersects, Inside };
+
+// tests a box against one plane using its center and the extent it reaches toward the plane
+static PlaneResult_ TestPlane(const float* plane, const Aabb& box)
+{
+  float distance = plane[3], reach = 0.0f;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    distance += plane[axis] * 0.5f * (box.min[axis] + box.max[axis]);
+    reach += fabsf(plane[axis]) * 0.5f * (box.max[axis] - box.min[axis]);
+  }
+  if (distance + reach < 0.0f)
+    return Outside;
+  return distance - reach < 0.0f ? Intersects : Inside;
+}
+
+// slab test, returns the entry distance or FLT_MAX if missed or farther than limit
+static float HitDistance(const Aabb& box, const float* origin, const float* inverse_direction, float limit)
+{
+  float near_t = 0.0f, far_t = limit;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    float t0 = (box.min[axis] - origin[axis]) * inverse_direction[axis];
+    float t1 = (box.max[axis] - origin[axis]) * inverse_direction[axis];
+    if (t0 > t1)
+      std::swap(t0, t1);
+    // fmax/fmin drop the NaN of a ray lying in a slab plane
+    near_t = fmaxf(near_t, t0);
+    far_t = fminf(far_t, t1);
+  }
+  return near_t <= far_t ? near_t : FLT_MAX;
+}
+
+// HELPER FUNCTIONS END
+
+static_assert(Bvh::MAX_LEAF_ITEMS == 4, "a leaf's items fill the 4 lanes of one SSE test");
+
+Bvh::Bvh() : root_(NO_NODE_), item_count_(0), built_area_(0.0), total_area_(0.0)
+{
+}
+
+void Bvh::Build(const unsigned* keys, const Aabb* bounds, unsigned count)
+{
+  unsigned key_limit = 0;
+  for (unsigned i = 0; i < count; ++i)
+    key_limit = std::max(key_limit, keys[i] + 1);
+  item_bounds_.assign(key_limit, Aabb::Empty());
+  leaf_of_.assign(key_limit, unsigned(NO_NODE_));
+
+  std::vector<BuildItem_> build(count);
+  for (unsigned i = 0; i < count; ++i)
+  {
+    item_bounds_[keys[i]] = bounds[i];
+    build[i].bounds = bounds[i];
+    build[i].key = keys[i];
+    for (int axis = 0; axis < 3; ++axis)
+      build[i].centroid[axis] = bounds[i].IsEmpty() ? 0.0f : 0.5f * (bounds[i].min[axis] + bounds[i].max[axis]);
+  }
+
+  nodes_.clear();
+  nodes_.reserve(count ? size_t(count) * 2 : 1);
+  lanes_.clear();
+  lanes_.reserve(nodes_.capacity());
+  free_nodes_.clear();
+  dirty_.clear();
+  total_area_ = 0.0;
+  item_count_ = count;
+  root_ = NO_NODE_;
+  if (count)
+  {
+    root_ = AllocateNode_(NO_NODE_);
+    std::vector<BuildRange_> stack(1, BuildRange_{root_, 0, count});
+    while (!stack.empty())
+    {
+      BuildRange_ range = stack.back();
+      stack.pop_back();
+      Split_(range, build, stack);
+    }
+    for (unsigned node = 0; node < nodes_.size(); ++node)
+      WriteLanes_(node);
+  }
+  built_area_ = total_area_;
+}
+
+void Bvh::Split_(BuildRange_ range, std::vector<BuildItem_>& build, std::vector<BuildRange_>& stack)
+{
+  BuildItem_* begin = build.data() + range.first;
+  BuildItem_* end = begin + range.count;
+  Aabb bounds = Aabb::Empty();
+  Aabb centroid_bounds = Aabb::Empty();
+  for (BuildItem_* it = begin; it != end; ++it)
+  {
+    bounds.Expand(it->bounds);
+    centroid_bounds.Expand(Aabb{{it->centroid[0], it->centroid[1], it->centroid[2]}, {it->centroid[0], it->centroid[1], it->centroid[2]}});
+  }
+  nodes_[range.node].bounds = bounds;
+  total_area_ += bounds.HalfArea();
+  if (range.count <= MAX_LEAF_ITEMS)
+  {
+    Node_& leaf = nodes_[range.node];
+    leaf.count = range.count;
+    for (unsigned i = 0; i < range.count; ++i)
+    {
+      leaf.items[i] = begin[i].key;
+      leaf_of_[begin[i].key] = range.node;
+    }
+    return;
+  }
+
+  // bin centroids on every axis at once, then sweep each axis for the cheapest split
+  Aabb bin_bounds[3][BINS];
+  unsigned bin_counts[3][BINS] = {};
+  float scale[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    float extent = centroid_bounds.max[axis] - centroid_bounds.min[axis];
+    scale[axis] = extent > 0.0f ? BINS / extent : 0.0f;
+    std::fill(bin_bounds[axis], bin_bounds[axis] + BINS, Aabb::Empty());
+  }
+  for (BuildItem_* it = begin; it != end; ++it)
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      unsigned bin = std::min(BINS - 1, unsigned((it->centroid[axis] - centroid_bounds.min[axis]) * scale[axis]));
+      bin_bounds[axis][bin].Expand(it->bounds);
+      ++bin_counts[axis][bin];
+    }
+
+  float best_cost = FLT_MAX;
+  int best_axis = -1;
+  unsigned best_split = 0;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (scale[axis] == 0.0f)
+      continue;
+
+    // right to left sums first, then the left to right sweep prices each split
+    float right_area[BINS];
+    unsigned right_count[BINS];
+    Aabb running = Aabb::Empty();
+    unsigned running_count = 0;
+    for (unsigned bin = BINS - 1; bin > 0; --bin)
+    {
+      running.Expand(bin_bounds[axis][bin]);
+      running_count += bin_counts[axis][bin];
+      right_area[bin] = running.HalfArea();
+      right_count[bin] = running_count;
+    }
+    running = Aabb::Empty();
+    running_count = 0;
+    for (unsigned split = 1; split < BINS; ++split)
+    {
+      running.Expand(bin_bounds[axis][split - 1]);
+      running_count += bin_counts[axis][split - 1];
+      float cost = running.HalfArea() * running_count + right_area[split] * right_count[split];
+      if (running_count && right_count[split] && cost < best_cost)
+      {
+        best_cost = cost;
+        best_axis = axis;
+        best_split = split;
+      }
+    }
+  }
+
+  BuildItem_* middle;
+  if (best_axis >= 0)
+  {
+    // a split costing more than a leaf is still taken, queries prefer small leaves
+    middle = std::partition(begin, end, [&](const BuildItem_& item)
+    {
+      return std::min(BINS - 1, unsigned((item.centroid[best_axis] - centroid_bounds.min[best_axis]) * scale[best_axis])) < best_split;
+    });
+  }
+  else
+  {
+    // every centroid is the same point, halve so leaves stay small
+    middle = begin + range.count / 2;
+  }
+
+  unsigned left_count = unsigned(middle - begin);
+  unsigned left = AllocateNode_(range.node);
+  unsigned right = AllocateNode_(range.node);
+  nodes_[range.node].left = left;
+  nodes_[range.node].right = right;
+  stack.push_back(BuildRange_{left, range.first, left_count});
+  stack.push_back(BuildRange_{right, range.first + left_count, range.count - left_count});
+}
+
+unsigned Bvh::AllocateNode_(unsigned parent)
+{
+  unsigned node;
+  if (free_nodes_.empty())
+  {
+    node = unsigned(nodes_.size());
+    nodes_.emplace_back();
+    lanes_.resize(nodes_.size());
+    dirty_.push_back(false);
+  }
+  else
+  {
+    node = free_nodes_.back();
+    free_nodes_.pop_back();
+  }
+  Node_& fresh = nodes_[node];
+  fresh.bounds = Aabb::Empty();
+  fresh.parent = parent;
+  fresh.left = NO_NODE_;
+  fresh.right = NO_NODE_;
+  fresh.count = 0;
+  return node;
+}
+
+void Bvh::FreeNode_(unsigned node)
+{
+  total_area_ -= nodes_[node].bounds.HalfArea();
+  dirty_[node] = false;
+  free_nodes_.push_back(node);
+}
+
+void Bvh::Insert(unsigned key, const Aabb& bounds)
+{
+  if (key >= leaf_of_.size())
+  {
+    item_bounds_.resize(size_t(key) + 1, Aabb::Empty());
+    leaf_of_.resize(size_t(key) + 1, unsigned(NO_NODE_));
+  }
+  item_bounds_[key] = bounds;
+  ++item_count_;
+  if (root_ == NO_NODE_)
+    root_ = AllocateNode_(NO_NODE_);
+
+  // descend toward the child whose box grows the least
+  unsigned node = root_;
+  while (nodes_[node].left != NO_NODE_)
+  {
+    const Node_& parent = nodes_[node];
+    Aabb left = nodes_[parent.left].bounds, right = nodes_[parent.right].bounds;
+    float left_area = left.HalfArea(), right_area = right.HalfArea();
+    left.Expand(bounds);
+    right.Expand(bounds);
+    node = left.HalfArea() - left_area <= right.HalfArea() - right_area ? parent.left : parent.right;
+  }
+
+  Node_& leaf = nodes_[node];
+  if (leaf.count < MAX_LEAF_ITEMS)
+  {
+    leaf.items[leaf.count++] = key;
+    leaf_of_[key] = node;
+  }
+  else
+    SplitLeaf_(node, key);
+  RefitToRoot_(node);
+}
+
+void Bvh::SplitLeaf_(unsigned leaf, unsigned key)
+{
+  unsigned keys[MAX_LEAF_ITEMS + 1];
+  std::copy(nodes_[leaf].items, nodes_[leaf].items + MAX_LEAF_ITEMS, keys);
+  keys[MAX_LEAF_ITEMS] = key;
+
+  Aabb centroids = Aabb::Empty();
+  for (unsigned item : keys)
+  {
+    const Aabb& box = item_bounds_[item];
+    float centroid[3] = {0.5f * (box.min[0] + box.max[0]), 0.5f * (box.min[1] + box.max[1]), 0.5f * (box.min[2] + box.max[2])};
+    if (!box.IsEmpty())
+      centroids.Expand(Aabb{{centroid[0], centroid[1], centroid[2]}, {centroid[0], centroid[1], centroid[2]}});
+  }
+  int axis = 0;
+  for (int other = 1; other < 3; ++other)
+    if (centroids.max[other] - centroids.min[other] > centroids.max[axis] - centroids.min[axis])
+      axis = other;
+  std::sort(keys, keys + MAX_LEAF_ITEMS + 1, [this, axis](unsigned a, unsigned b)
+  {
+    return item_bounds_[a].min[axis] + item_bounds_[a].max[axis] < item_bounds_[b].min[axis] + item_bounds_[b].max[axis];
+  });
+
+  // the leaf keeps its index and becomes the parent, so nothing above it changes
+  unsigned left = AllocateNode_(leaf);
+  unsigned right = AllocateNode_(leaf);
+  const unsigned LEFT_COUNT = (MAX_LEAF_ITEMS + 1) / 2;
+  for (unsigned i = 0; i <= MAX_LEAF_ITEMS; ++i)
+  {
+    unsigned child = i < LEFT_COUNT ? left : right;
+    nodes_[child].items[nodes_[child].count++] = keys[i];
+    leaf_of_[keys[i]] = child;
+  }
+  nodes_[leaf].left = left;
+  nodes_[leaf].right = right;
+  nodes_[leaf].count = 0;
+  RecomputeBounds_(left);
+  RecomputeBounds_(right);
+}
+
+void Bvh::Remove(unsigned key)
+{
+  unsigned leaf = leaf_of_[key];
+  leaf_of_[key] = NO_NODE_;
+  item_bounds_[key] = Aabb::Empty();
+  --item_count_;
+
+  Node_& node = nodes_[leaf];
+  for (unsigned i = 0; i < node.count; ++i)
+    if (node.items[i] == key)
+    {
+      node.items[i] = node.items[--node.count];
+      break;
+    }
+  if (node.count)
+  {
+    RefitToRoot_(leaf);
+    return;
+  }
+
+  // an empty leaf goes, and its sibling takes the place of their parent
+  unsigned parent = node.parent;
+  FreeNode_(leaf);
+  if (parent == NO_NODE_)
+  {
+    root_ = NO_NODE_;
+    return;
+  }
+  unsigned sibling = nodes_[parent].left == leaf ? nodes_[parent].right : nodes_[parent].left;
+  unsigned grandparent = nodes_[parent].parent;
+  nodes_[sibling].parent = grandparent;
+  FreeNode_(parent);
+  if (grandparent == NO_NODE_)
+  {
+    root_ = sibling;
+    return;
+  }
+  if (nodes_[grandparent].left == parent)
+    nodes_[grandparent].left = sibling;
+  else
+    nodes_[grandparent].right = sibling;
+  RefitToRoot_(grandparent);
+}
+
+void Bvh::Update(unsigned key, const Aabb& bounds)
+{
+  item_bounds_[key] = bounds;
+  // mark the path to the root, stopping where another update already did
+  for (unsigned node = leaf_of_[key]; node != NO_NODE_ && !dirty_[node]; node = nodes_[node].parent)
+    dirty_[node] = true;
+}
+
+void Bvh::Refit()
+{
+  if (root_ == NO_NODE_ || !dirty_[root_])
+    return;
+
+  // post order over the dirty nodes, a node is pushed again marked by its high bit once its children are pushed
+  const unsigned CHILDREN_PUSHED = 1u << 31;
+  refit_stack_.clear();
+  refit_stack_.push_back(root_);
+  while (!refit_stack_.empty())
+  {
+    unsigned entry = refit_stack_.back();
+    refit_stack_.pop_back();
+    unsigned node = entry & ~CHILDREN_PUSHED;
+    if ((entry & CHILDREN_PUSHED) || nodes_[node].left == NO_NODE_)
+    {
+      dirty_[node] = false;
+      RecomputeBounds_(node);
+      continue;
+    }
+    refit_stack_.push_back(node | CHILDREN_PUSHED);
+    if (dirty_[nodes_[node].left])
+      refit_stack_.push_back(nodes_[node].left);
+    if (dirty_[nodes_[node].right])
+      refit_stack_.push_back(nodes_[node].right);
+  }
+}
+
+void Bvh::RecomputeBounds_(unsigned index)
+{
+  Node_& node = nodes_[index];
+  Aabb bounds = Aabb::Empty();
+  if (node.left != NO_NODE_)
+  {
+    bounds = nodes_[node.left].bounds;
+    bounds.Expand(nodes_[node.right].bounds);
+  }
+  else
+    for (unsigned i = 0; i < node.count; ++i)
+      bounds.Expand(item_bounds_[node.items[i]]);
+
+  total_area_ += double(bounds.HalfArea()) - double(node.bounds.HalfArea());
+  node.bounds = bounds;
+  WriteLanes_(index);
+}
+
+void Bvh::WriteLanes_(unsigned index)
+{
+  const Node_& node = nodes_[index];
+  Lanes_& lanes = lanes_[index];
+  for (unsigned lane = 0; lane < 4; ++lane)
+  {
+    const Aabb* box = nullptr;
+    if (node.left != NO_NODE_)
+      box = lane < 2 ? &nodes_[lane ? node.right : node.left].bounds : nullptr;
+    else if (lane < node.count)
+      box = &item_bounds_[node.items[lane]];
+
+    if (!box || box->IsEmpty())
+    {
+      // a negative reach leaves the lane outside whatever the plane
+      lanes.center_x[lane] = lanes.center_y[lane] = lanes.center_z[lane] = 0.0f;
+      lanes.radius[lane] = lanes.extent_x[lane] = lanes.extent_y[lane] = lanes.extent_z[lane] = -1e30f;
+      continue;
+    }
+    lanes.center_x[lane] = 0.5f * (box->min[0] + box->max[0]);
+    lanes.center_y[lane] = 0.5f * (box->min[1] + box->max[1]);
+    lanes.center_z[lane] = 0.5f * (box->min[2] + box->max[2]);
+    lanes.radius[lane] = FLT_MAX;
+    lanes.extent_x[lane] = 0.5f * (box->max[0] - box->min[0]);
+    lanes.extent_y[lane] = 0.5f * (box->max[1] - box->min[1]);
+    lanes.extent_z[lane] = 0.5f * (box->max[2] - box->min[2]);
+  }
+}
+
+void Bvh::RefitToRoot_(unsigned node)
+{
+  for (; node != NO_NODE_; node = nodes_[node].parent)
+    RecomputeBounds_(node);
+}
+
+bool Bvh::NeedsRebuild() const
+{
+  return total_area_ > built_area_ * REBUILD_AREA_RATIO;
+}
+
+unsigned Bvh::EmitAll_(unsigned root, unsigned* visible) const
+{
+  unsigned stack[64];
+  unsigned depth = 0, count = 0;
+  stack[depth++] = root;
+  while (depth)
+  {
+    const Node_& node = nodes_[stack[--depth]];
+    if (node.left == NO_NODE_)
+    {
+      for (unsigned i = 0; i < node.count; ++i)
+        if (!item_bounds_[node.items[i]].IsEmpty())
+          visible[count++] = node.items[i];
+    }
+    else if (depth + 2 <= 64)
+    {
+      stack[depth++] = node.right;
+      stack[depth++] = node.left;
+    }
+    else
+    {
+      count += EmitAll_(node.left, visible + count);
+      count += EmitAll_(node.right, visible + count);
+    }
+  }
+  return count;
+}
+
+unsigned Bvh::CullFrustum(const Frustum& frustum, unsigned* visible) const
+{
+  if (root_ == NO_NODE_ || nodes_[root_].bounds.IsEmpty())
+    return 0;
+
+  // the root has no parent to test it with its sibling, so it is tested alone
+  unsigned planes = 0;
+  for (int side = 0; side < Frustum::SIDES; ++side)
+  {
+    PlaneResult_ result = TestPlane(frustum.planes[side], nodes_[root_].bounds);
+    if (result == Outside)
+      return 0;
+    if (result == Intersects)
+      planes |= 1u << side;
+  }
+  return planes ? CullSubtree_(frustum, root_, planes, visible) : EmitAll_(root_, visible);
+}
+
+unsigned Bvh::CullSubtree_(const Frustum& frustum, unsigned root, unsigned root_planes, unsigned* visible) const
+{
+  // each entry carries the planes it intersects, its children or items need no test against the others
+  struct Entry { unsigned node; unsigned planes; };
+  Entry stack[64];
+  unsigned depth = 0, count = 0;
+  stack[depth++] = Entry{root, root_planes};
+
+  while (depth)
+  {
+    Entry entry = stack[--depth];
+    const Node_& node = nodes_[entry.node];
+    const Lanes_& lanes = lanes_[entry.node];
+    int intersects[Frustum::SIDES] = {};
+    int outside = CullFrustum4(frustum, entry.planes, lanes.center_x, lanes.center_y, lanes.center_z, lanes.radius,
+                               lanes.extent_x, lanes.extent_y, lanes.extent_z, intersects);
+    if (node.left == NO_NODE_)
+    {
+      for (unsigned lane = 0; lane < node.count; ++lane)
+        if (!(outside & (1 << lane)))
+          visible[count++] = node.items[lane];
+      continue;
+    }
+
+    // the right child first, so the left is popped first
+    for (int lane = 1; lane >= 0; --lane)
+    {
+      if (outside & (1 << lane))
+        continue;
+      unsigned child = lane ? node.right : node.left;
+      unsigned planes = 0;
+      for (int side = 0; side < Frustum::SIDES; ++side)
+        if ((entry.planes & (1u << side)) && (intersects[side] & (1 << lane)))
+          planes |= 1u << side;
+
+      if (!planes)
+        count += EmitAll_(child, visible + count);
+      else if (depth < 64)
+        stack[depth++] = Entry{child, planes};
+      // the stack only overflows on degenerate trees, the child gets a stack of its own
+      else
+        count += CullSubtree_(frustum, child, planes, visible + count);
+    }
+  }
+  return count;
+}
+
+bool Bvh::Raycast(const float* origin, const float* direction, unsigned& key, float& distance) const
+{
+  if (root_ == NO_NODE_)
+    return false;
+
+  float inverse_direction[3];
+  for (int axis = 0; axis < 3; ++axis)
+    inverse_direction[axis] = 1.0f / direction[axis];
+
+  float best = FLT_MAX;
+  float root = HitDistance(nodes_[root_].bounds, origin, inverse_direction, best);
+  if (root != FLT_MAX)
+    RaycastSubtree_(root_, root, origin, inverse_direction, key, best);
+
+  distance = best;
+  return best != FLT_MAX;
+}
+
+void Bvh::RaycastSubtree_(unsigned root, float root_distance, const float* origin, const float* inverse_direction, unsigned& key, float& best) const
+{
+  struct Entry { unsigned node; float distance; };
+  Entry stack[64];
+  unsigned depth = 0;
+  stack[depth++] = Entry{root, root_distance};
+
+  while (depth)
+  {
+    Entry entry = stack[--depth];
+    // a closer hit was found since this node was pushed
+    if (entry.distance >= best)
+      continue;
+
+    const Node_& node = nodes_[entry.node];
+    if (node.left == NO_NODE_)
+    {
+      for (unsigned i = 0; i < node.count; ++i)
+      {
+        const Aabb& bounds = item_bounds_[node.items[i]];
+        float hit = bounds.IsEmpty() ? FLT_MAX : HitDistance(bounds, origin, inverse_direction, best);
+        if (hit < best)
+        {
+          best = hit;
+          key = node.items[i];
+        }
+      }
+      continue;
+    }
+
+    // push the farther child first so the nearer is visited first
+    float left = HitDistance(nodes_[node.left].bounds, origin, inverse_direction, best);
+    float right = HitDistance(nodes_[node.right].bounds, origin, inverse_direction, best);
+    Entry near_entry{node.left, left}, far_entry{node.right, right};
+    if (right < left)
+      std::swap(near_entry, far_entry);
+    if (depth + 2 <= 64)
+    {
+      if (far_entry.distance != FLT_MAX)
+        stack[depth++] = far_entry;
+      if (near_entry.distance != FLT_MAX)
+        stack[depth++] = near_entry;
+    }
+    // the stack only overflows on degenerate trees, the children get stacks of their own
+    else
+    {
+      if (near_entry.distance != FLT_MAX)
+        RaycastSubtree_(near_entry.node, near_entry.distance, origin, inverse_direction, key, best);
+      if (far_entry.distance != FLT_MAX && far_entry.distance < best)
+        RaycastSubtree_(far_entry.node, far_entry.distance, origin, inverse_direction, key, best);
+    }
+  }
+}
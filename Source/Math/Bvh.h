@@ -0,0 +1,209 @@
+/*! \file Bvh.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains Aabb and Bvh, a bounding volume hierarchy for culling and picking many objects.
+*/
+
+#pragma once
+
+#include "Frustum.h"
+
+#include <cstddef>
+#include <vector>
+
+//! An axis aligned box, empty when min is greater than max.
+struct Aabb
+{
+  //! \return A box that contains nothing and never intersects anything.
+  static Aabb Empty();
+
+  //! \return True if the box contains nothing.
+  bool IsEmpty() const { return min[0] > max[0]; }
+
+  //! \brief Grows the box to contain another.
+  void Expand(const Aabb& other);
+
+  //! \return Half the surface area, the probability weight of the surface area heuristic, 0 if empty.
+  float HalfArea() const;
+
+  float min[3];
+  float max[3];
+};
+
+/*! A binary tree of boxes over items named by keys, such as the slot index
+    of an Object handle, which stays the same for the Object's lifetime.
+
+    Build splits with the surface area heuristic over binned centroids.
+    Insert and Remove change one leaf and refit the boxes above it, and
+    moving items only refits the boxes on the path to the root. Both keep
+    queries correct but let the tree degrade, so NeedsRebuild reports when
+    the total box area has grown enough to build again.
+
+    Every node also keeps the boxes of its children or items side by side,
+    so culling tests them 4 at a time with the SSE kernel of Culling.h.
+*/
+class Bvh
+{
+  public:
+    //! Leaves hold at most this many items.
+    static const unsigned MAX_LEAF_ITEMS = 4;
+    //! Centroid bins per axis tried by the split search.
+    static const unsigned BINS = 16;
+    //! NeedsRebuild is true once inserts and refits grow the total area by this factor.
+    static constexpr float REBUILD_AREA_RATIO = 1.5f;
+
+    Bvh();
+
+    /*! \brief Builds the tree from scratch, replacing every item.
+        \param keys The key of every item, all different. The storage kept per key grows with the largest.
+        \param bounds The box of every item, copied. Empty boxes are kept but never returned by queries.
+        \param count The number of items.
+    */
+    void Build(const unsigned* keys, const Aabb* bounds, unsigned count);
+
+    /*! \brief Adds an item to the leaf whose box grows the least, splitting it if full, and refits the boxes above.
+        \param key The key of the item, not in the tree.
+        \param bounds The box of the item, not empty, or it would be placed without regard to the others.
+    */
+    void Insert(unsigned key, const Aabb& bounds);
+
+    /*! \brief Removes an item, collapsing its leaf into the sibling once empty, and refits the boxes above.
+        \param key The key of the item, in the tree.
+    */
+    void Remove(unsigned key);
+
+    //! \return True if an item with the key is in the tree.
+    bool Contains(unsigned key) const { return key < leaf_of_.size() && leaf_of_[key] != NO_NODE_; }
+
+    /*! \brief Changes the box of an item, the tree is not correct again until Refit.
+        \param key The key of the item, in the tree.
+        \param bounds The new box.
+    */
+    void Update(unsigned key, const Aabb& bounds);
+
+    //! \brief Refits the boxes above every item changed since the last Refit.
+    void Refit();
+
+    //! \return True if inserts and refits degraded the tree enough that Build should be called again.
+    bool NeedsRebuild() const;
+
+    /*! \brief Finds every item whose box intersects the frustum.
+        \param frustum The planes to test against.
+        \param visible Receives the keys, room for Size().
+        \return The number of keys written.
+    */
+    unsigned CullFrustum(const Frustum& frustum, unsigned* visible) const;
+
+    /*! \brief Finds the item whose box is hit first by a ray.
+        \param origin The start of the ray.
+        \param direction The direction of the ray, need not be normalized.
+        \param key Receives the key of the item hit.
+        \param distance Receives the distance along the ray in lengths of direction, 0 if the origin is inside.
+        \return False if no box is hit.
+    */
+    bool Raycast(const float* origin, const float* direction, unsigned& key, float& distance) const;
+
+    //! \return The number of items.
+    unsigned Size() const { return item_count_; }
+    //! \return The number of nodes in use.
+    size_t NodeCount() const { return nodes_.size() - free_nodes_.size(); }
+
+  private:
+    //! Marks a missing node, or a key not in the tree.
+    static const unsigned NO_NODE_ = ~0u;
+
+    struct Node_
+    {
+      Aabb bounds;
+      //! NO_NODE_ for the root.
+      unsigned parent;
+      //! Children, NO_NODE_ for leaves. Internal nodes always have both.
+      unsigned left;
+      unsigned right;
+      //! Keys of a leaf.
+      unsigned count;
+      unsigned items[MAX_LEAF_ITEMS];
+    };
+
+    //! An item while building, kept contiguous so binning reads memory in order.
+    struct BuildItem_
+    {
+      Aabb bounds;
+      float centroid[3];
+      unsigned key;
+    };
+
+    //! Boxes of a node's children or items for CullFrustum4, unused and empty lanes are outside every plane.
+    struct alignas(16) Lanes_
+    {
+      float center_x[4];
+      float center_y[4];
+      float center_z[4];
+      //! Boxes have no sphere, so lanes in use have no limit here.
+      float radius[4];
+      float extent_x[4];
+      float extent_y[4];
+      float extent_z[4];
+    };
+
+    //! A node and the build items under it, waiting to be split.
+    struct BuildRange_
+    {
+      unsigned node;
+      unsigned first;
+      unsigned count;
+    };
+
+    //! \brief Splits a node with the surface area heuristic, or makes it a leaf.
+    void Split_(BuildRange_ range, std::vector<BuildItem_>& build, std::vector<BuildRange_>& stack);
+
+    //! \brief Gives a leaf a full load of items plus one more by splitting it at the median of the longest axis.
+    void SplitLeaf_(unsigned leaf, unsigned key);
+
+    //! \return A new empty leaf, reusing a freed node if there is one.
+    unsigned AllocateNode_(unsigned parent);
+
+    //! \brief Returns a node to the free list.
+    void FreeNode_(unsigned node);
+
+    //! \brief Recomputes a node box and lanes from its children or items, keeping total_area_ current.
+    void RecomputeBounds_(unsigned node);
+
+    //! \brief Copies the boxes of a node's children or items into its lanes.
+    void WriteLanes_(unsigned node);
+
+    //! \brief Recomputes the boxes of a node and every node above it.
+    void RefitToRoot_(unsigned node);
+
+    /*! \brief Culls the subtree under a node already known to be visible, CullFrustum starts it at the root.
+        \param root_planes The planes root intersects, it is inside the others.
+    */
+    unsigned CullSubtree_(const Frustum& frustum, unsigned root, unsigned root_planes, unsigned* visible) const;
+
+    /*! \brief Raycasts the subtree under a node the ray hits, Raycast starts it at the root.
+        \param root_distance Where the ray enters root.
+        \param key Receives the key of a hit closer than best.
+        \param best The closest hit so far, lowered by any closer hit.
+    */
+    void RaycastSubtree_(unsigned root, float root_distance, const float* origin, const float* inverse_direction, unsigned& key, float& best) const;
+
+    //! \brief Writes every non-empty item under a node.
+    unsigned EmitAll_(unsigned root, unsigned* visible) const;
+
+    std::vector<Node_> nodes_;
+    //! Lanes of each node, apart from nodes_ so culling reads only what it tests.
+    std::vector<Lanes_> lanes_;
+    std::vector<unsigned> free_nodes_;
+    unsigned root_;
+    unsigned item_count_;
+    //! Box and leaf of each key, NO_NODE_ for keys not in the tree.
+    std::vector<Aabb> item_bounds_;
+    std::vector<unsigned> leaf_of_;
+    //! Set on nodes above items changed since the last Refit, so every dirty node has dirty ancestors.
+    std::vector<bool> dirty_;
+    //! Nodes waiting to be refit, kept to reuse its storage.
+    std::vector<unsigned> refit_stack_;
+    //! Sum of node half areas after Build and as of now.
+    double built_area_;
+    double total_area_;
+};
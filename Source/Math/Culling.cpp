@@ -0,0 +1,166 @@
+/*! \file Culling.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of BoundsSoA and the frustum culling kernels.
+*/
+
+#include "Culling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+// the AVX kernel is compiled for AVX whatever the build targets, and only called once the CPU reports it
+#if defined(_MSC_VER)
+  // MSVC emits AVX intrinsics without /arch:AVX
+  #define AVX_FUNCTION
+#else
+  #define AVX_FUNCTION __attribute__((target("avx")))
+#endif
+
+void BoundsSoA::Clear()
+{
+  center_x.clear();
+  center_y.clear();
+  center_z.clear();
+  radius.clear();
+  extent_x.clear();
+  extent_y.clear();
+  extent_z.clear();
+}
+
+void BoundsSoA::Reserve(size_t count)
+{
+  center_x.reserve(count);
+  center_y.reserve(count);
+  center_z.reserve(count);
+  radius.reserve(count);
+  extent_x.reserve(count);
+  extent_y.reserve(count);
+  extent_z.reserve(count);
+}
+
+unsigned BoundsSoA::Add(const float* center, float radius_, const float* extents)
+{
+  center_x.push_back(center[0]);
+  center_y.push_back(center[1]);
+  center_z.push_back(center[2]);
+  radius.push_back(radius_);
+  extent_x.push_back(extents[0]);
+  extent_y.push_back(extents[1]);
+  extent_z.push_back(extents[2]);
+  return unsigned(center_x.size() - 1);
+}
+
+// HELPER FUNCTIONS START
+
+//! \return True if the CPU and OS support AVX, checked once.
+static bool HasAvx()
+{
+  static const bool has_avx = []()
+  {
+#if defined(_MSC_VER)
+    // AVX and OSXSAVE in cpuid, then the OS must save the ymm registers
+    int info[4];
+    __cpuid(info, 1);
+    bool cpu = (info[2] & (1 << 28)) && (info[2] & (1 << 27));
+    return cpu && (_xgetbv(0) & 6) == 6;
+#else
+    return __builtin_cpu_supports("avx") != 0;
+#endif
+  }();
+  return has_avx;
+}
+
+// 8 bounds at a time, returns the index after the last one tested
+AVX_FUNCTION static size_t CullAvx(const Frustum& frustum, const BoundsSoA& bounds, unsigned* visible, unsigned& count)
+{
+  size_t size = bounds.Size() & ~size_t(7);
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  for (size_t i = 0; i < size; i += 8)
+  {
+    __m256 x = _mm256_loadu_ps(&bounds.center_x[i]);
+    __m256 y = _mm256_loadu_ps(&bounds.center_y[i]);
+    __m256 z = _mm256_loadu_ps(&bounds.center_z[i]);
+    __m256 r = _mm256_loadu_ps(&bounds.radius[i]);
+    __m256 ex = _mm256_loadu_ps(&bounds.extent_x[i]);
+    __m256 ey = _mm256_loadu_ps(&bounds.extent_y[i]);
+    __m256 ez = _mm256_loadu_ps(&bounds.extent_z[i]);
+    __m256 outside = _mm256_setzero_ps();
+    
+    for (int side = 0; side < Frustum::SIDES; ++side)
+    {
+      const float* plane = frustum.planes[side];
+      __m256 px = _mm256_set1_ps(plane[0]), py = _mm256_set1_ps(plane[1]), pz = _mm256_set1_ps(plane[2]);
+      __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px, x), _mm256_mul_ps(py, y)), _mm256_add_ps(_mm256_mul_ps(pz, z), _mm256_set1_ps(plane[3])));
+      __m256 box = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(sign_mask, px), ex), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, py), ey)), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, pz), ez));
+      __m256 reach = _mm256_min_ps(r, box);
+      outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), _mm256_setzero_ps(), _CMP_LT_OQ));
+    }
+    
+    int bits = ~_mm256_movemask_ps(outside) & 0xFF;
+    for (unsigned lane = 0; bits; ++lane, bits >>= 1)
+      if (bits & 1)
+        visible[count++] = unsigned(i) + lane;
+  }
+  return size;
+}
+
+// 4 bounds at a time, returns the index after the last one tested
+static size_t CullSse(const Frustum& frustum, const BoundsSoA& bounds, unsigned* visible, unsigned& count, size_t first)
+{
+  size_t size = first + ((bounds.Size() - first) & ~size_t(3));
+  const unsigned ALL_PLANES = (1u << Frustum::SIDES) - 1;
+  for (size_t i = first; i < size; i += 4)
+  {
+    int outside = CullFrustum4(frustum, ALL_PLANES, &bounds.center_x[i], &bounds.center_y[i], &bounds.center_z[i], &bounds.radius[i],
+                               &bounds.extent_x[i], &bounds.extent_y[i], &bounds.extent_z[i]);
+    
+    // a table lookup would avoid the branches, but most groups are all in or all out
+    int bits = ~outside & 0xF;
+    for (unsigned lane = 0; bits; ++lane, bits >>= 1)
+      if (bits & 1)
+        visible[count++] = unsigned(i) + lane;
+  }
+  return size;
+}
+
+// HELPER FUNCTIONS END
+
+unsigned CullFrustum(const Frustum& frustum, const BoundsSoA& bounds, unsigned* visible)
+{
+  unsigned count = 0;
+  size_t next = 0;
+  if (HasAvx())
+    next = CullAvx(frustum, bounds, visible, count);
+  next = CullSse(frustum, bounds, visible, count, next);
+  return count + CullFrustumScalar(frustum, bounds, visible + count, next);
+}
+
+unsigned CullFrustumScalar(const Frustum& frustum, const BoundsSoA& bounds, unsigned* visible, size_t first)
+{
+  unsigned count = 0;
+  for (size_t i = first; i < bounds.Size(); ++i)
+  {
+    bool outside = false;
+    for (int side = 0; side < Frustum::SIDES && !outside; ++side)
+    {
+      const float* plane = frustum.planes[side];
+      float distance = plane[0] * bounds.center_x[i] + plane[1] * bounds.center_y[i] + plane[2] * bounds.center_z[i] + plane[3];
+      float box = fabsf(plane[0]) * bounds.extent_x[i] + fabsf(plane[1]) * bounds.extent_y[i] + fabsf(plane[2]) * bounds.extent_z[i];
+      outside = distance + std::min(bounds.radius[i], box) < 0.0f;
+    }
+    if (!outside)
+      visible[count++] = unsigned(i);
+  }
+  return count;
+}
+
+bool CullFrustumUsesAvx()
+{
+  return HasAvx();
+}
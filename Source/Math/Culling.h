@@ -0,0 +1,94 @@
+/*! \file Culling.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains BoundsSoA, bounding volumes stored for SIMD tests, and the frustum culling kernels.
+*/
+
+#pragma once
+
+#include "Frustum.h"
+
+#include <cstddef>
+#include <emmintrin.h>
+#include <vector>
+
+/*! Bounding volumes of many objects, a sphere and an axis aligned box
+    sharing a center, with each component in its own array so the kernels
+    load 4 or 8 objects with one instruction.
+*/
+struct BoundsSoA
+{
+  //! \brief Removes every bounds, keeping the memory.
+  void Clear();
+  
+  //! \brief Makes room for count bounds in every array.
+  void Reserve(size_t count);
+  
+  /*! \brief Adds one object's bounds.
+      \param center The world center of the box and sphere.
+      \param radius The world radius of the sphere.
+      \param extents The world half size of the box on each axis.
+      \return The index of the bounds, which CullFrustum writes for visible objects.
+  */
+  unsigned Add(const float* center, float radius, const float* extents);
+  
+  //! \return The number of bounds.
+  size_t Size() const { return center_x.size(); }
+  
+  std::vector<float> center_x;
+  std::vector<float> center_y;
+  std::vector<float> center_z;
+  std::vector<float> radius;
+  std::vector<float> extent_x;
+  std::vector<float> extent_y;
+  std::vector<float> extent_z;
+};
+
+/*! \brief Finds the bounds that may be visible, 8 at a time with AVX if the CPU has it or 4 with SSE.
+
+    An object is culled when its sphere or its box is fully outside one plane.
+    Both share a center, so each plane costs one dot product and a min of
+    the sphere radius and the box's projected extent.
+    \param frustum The planes to test against.
+    \param bounds The bounds to test.
+    \param visible Receives the indices of bounds that may be visible in order, room for bounds.Size().
+    \return The number of indices written.
+*/
+unsigned CullFrustum(const Frustum& frustum, const BoundsSoA& bounds, unsigned* visible);
+
+//! \return True if CullFrustum runs the AVX kernel on this CPU, otherwise it runs the SSE one.
+bool CullFrustumUsesAvx();
+
+/*! \brief Tests 4 bounds laid out like BoundsSoA against some of the planes, the SSE kernel of CullFrustum and Bvh.
+    \param frustum The planes to test against.
+    \param planes A bit per Frustum::Side to test.
+    \param center_x The first of 4 values, and the same for every component.
+    \param intersects If not null, receives for each plane tested a bit per lane that crosses it.
+    \return A bit per lane fully outside one of the planes.
+*/
+inline int CullFrustum4(const Frustum& frustum, unsigned planes, const float* center_x, const float* center_y, const float* center_z, const float* radius,
+                        const float* extent_x, const float* extent_y, const float* extent_z, int* intersects = nullptr)
+{
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  __m128 x = _mm_loadu_ps(center_x), y = _mm_loadu_ps(center_y), z = _mm_loadu_ps(center_z), r = _mm_loadu_ps(radius);
+  __m128 ex = _mm_loadu_ps(extent_x), ey = _mm_loadu_ps(extent_y), ez = _mm_loadu_ps(extent_z);
+  __m128 outside = _mm_setzero_ps();
+  for (int side = 0; side < Frustum::SIDES; ++side)
+  {
+    if (!(planes & (1u << side)))
+      continue;
+    const float* plane = frustum.planes[side];
+    __m128 px = _mm_set1_ps(plane[0]), py = _mm_set1_ps(plane[1]), pz = _mm_set1_ps(plane[2]);
+    __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, x), _mm_mul_ps(py, y)), _mm_add_ps(_mm_mul_ps(pz, z), _mm_set1_ps(plane[3])));
+    // the box reaches |n| . extents toward the plane, the sphere its radius, whichever is tighter decides
+    __m128 box = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign_mask, px), ex), _mm_mul_ps(_mm_andnot_ps(sign_mask, py), ey)), _mm_mul_ps(_mm_andnot_ps(sign_mask, pz), ez));
+    __m128 reach = _mm_min_ps(r, box);
+    outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), _mm_setzero_ps()));
+    if (intersects)
+      intersects[side] = _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, reach), _mm_setzero_ps()));
+  }
+  return _mm_movemask_ps(outside);
+}
+
+//! \brief The one at a time version of CullFrustum, for the tail of the arrays and for comparison.
+unsigned CullFrustumScalar(const Frustum& frustum, const BoundsSoA& bounds, unsigned* visible, size_t first = 0);
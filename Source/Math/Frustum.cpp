@@ -0,0 +1,38 @@
+/*! \file Frustum.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of Frustum.
+*/
+
+#include "Frustum.h"
+#include <cmath>
+
+void Frustum::FromMatrix(const float* m)
+{
+  // each plane is the last row plus or minus another row, the rows of a column major matrix are strided by 4
+  for (int side = 0; side < SIDES; ++side)
+  {
+    int row = side / 2;
+    float sign = side % 2 ? -1.0f : 1.0f;
+    float length = 0.0f;
+    for (int i = 0; i < 4; ++i)
+    {
+      planes[side][i] = m[i * 4 + 3] + sign * m[i * 4 + row];
+      if (i < 3)
+        length += planes[side][i] * planes[side][i];
+    }
+    
+    // unit normals make the plane equation a distance, so spheres can be tested against it
+    float inverse = length > 0.0f ? 1.0f / sqrtf(length) : 0.0f;
+    for (int i = 0; i < 4; ++i)
+      planes[side][i] *= inverse;
+  }
+}
+
+bool Frustum::IntersectsSphere(float x, float y, float z, float radius) const
+{
+  for (int side = 0; side < SIDES; ++side)
+    if (planes[side][0] * x + planes[side][1] * y + planes[side][2] * z + planes[side][3] < -radius)
+      return false;
+  return true;
+}
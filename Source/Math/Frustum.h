@@ -0,0 +1,30 @@
+/*! \file Frustum.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains the Frustum struct, the six planes bounding what a camera sees.
+*/
+
+#pragma once
+
+//! Six planes facing inward, a point p is inside a plane if dot(normal, p) + distance >= 0.
+struct Frustum
+{
+  enum Side { Left, Right, Bottom, Top, Near, Far, SIDES };
+  
+  /*! \brief Extracts the planes from a view-projection matrix with GL clip space, -w to w on every axis.
+      \param view_projection The column major matrix, 16 floats.
+  */
+  void FromMatrix(const float* view_projection);
+  
+  /*! \brief Tests a sphere against every plane.
+      \param x The x of the center.
+      \param y The y of the center.
+      \param z The z of the center.
+      \param radius The radius of the sphere.
+      \return False if the sphere is fully outside a plane, true if it may be visible.
+  */
+  bool IntersectsSphere(float x, float y, float z, float radius) const;
+  
+  //! Normalized planes as x, y, z of the normal followed by the distance.
+  float planes[SIDES][4];
+};
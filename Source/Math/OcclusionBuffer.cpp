@@ -0,0 +1,267 @@
+/*! \file OcclusionBuffer.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of OcclusionBuffer.
+*/
+
+#include "OcclusionBuffer.h"
+#include "../Threading/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
+
+// HELPER FUNCTIONS START
+
+// column major a * b
+static void MultiplyMatrices(const float* a, const float* b, float* result)
+{
+  for (int column = 0; column < 4; ++column)
+    for (int row = 0; row < 4; ++row)
+    {
+      float sum = 0.0f;
+      for (int k = 0; k < 4; ++k)
+        sum += a[k * 4 + row] * b[column * 4 + k];
+      result[column * 4 + row] = sum;
+    }
+}
+
+// clip space position of a point, returns false if it is behind the near plane
+static bool ToClip(const float* matrix, float x, float y, float z, float* clip)
+{
+  for (int row = 0; row < 4; ++row)
+    clip[row] = matrix[row] * x + matrix[4 + row] * y + matrix[8 + row] * z + matrix[12 + row];
+  return clip[3] > 0.0f && clip[2] >= -clip[3];
+}
+
+// HELPER FUNCTIONS END
+
+OcclusionBuffer::OcclusionBuffer() : depth_(WIDTH * HEIGHT, 1.0f), scratch_(WIDTH * HEIGHT, 1.0f), tile_max_(TILES_X * TILES_Y, 1.0f)
+{
+  memset(view_projection_, 0, sizeof(view_projection_));
+}
+
+void OcclusionBuffer::Begin(const float* view_projection)
+{
+  memcpy(view_projection_, view_projection, sizeof(view_projection_));
+  triangles_.clear();
+  stats_ = Stats();
+}
+
+void OcclusionBuffer::AddOccluder(const float* model, const float* positions, const unsigned* indices, unsigned index_count)
+{
+  float matrix[16];
+  MultiplyMatrices(view_projection_, model, matrix);
+  ++stats_.occluders;
+
+  for (unsigned i = 0; i + 2 < index_count; i += 3)
+  {
+    float x[3], y[3], z[3];
+    bool in_front = true;
+    for (int corner = 0; corner < 3 && in_front; ++corner)
+    {
+      const float* position = positions + size_t(indices[i + corner]) * 3;
+      float clip[4];
+      in_front = ToClip(matrix, position[0], position[1], position[2], clip);
+      x[corner] = (clip[0] / clip[3] * 0.5f + 0.5f) * WIDTH;
+      y[corner] = (clip[1] / clip[3] * 0.5f + 0.5f) * HEIGHT;
+      z[corner] = clip[2] / clip[3];
+    }
+    if (!in_front)
+      continue;
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (fabsf(area) < 1e-6f)
+      continue;
+
+    Triangle_ triangle;
+    triangle.min_x = std::max(0, int(floorf(std::min(x[0], std::min(x[1], x[2])))));
+    triangle.min_y = std::max(0, int(floorf(std::min(y[0], std::min(y[1], y[2])))));
+    triangle.max_x = std::min(int(WIDTH) - 1, int(ceilf(std::max(x[0], std::max(x[1], x[2])))));
+    triangle.max_y = std::min(int(HEIGHT) - 1, int(ceilf(std::max(y[0], std::max(y[1], y[2])))));
+    if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y)
+      continue;
+
+    // occluders are solid from both sides, flip clockwise triangles so inside is positive
+    float sign = area > 0.0f ? 1.0f : -1.0f;
+    for (int edge = 0; edge < 3; ++edge)
+    {
+      int next = (edge + 1) % 3;
+      triangle.edge_a[edge] = sign * (y[edge] - y[next]);
+      triangle.edge_b[edge] = sign * (x[next] - x[edge]);
+      triangle.edge_c[edge] = sign * (x[edge] * y[next] - x[next] * y[edge]);
+    }
+
+    triangle.dzdx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+    triangle.dzdy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+    // the farthest the plane gets within half a pixel of the center
+    triangle.z0 = z[0] - triangle.dzdx * x[0] - triangle.dzdy * y[0] + 0.5f * (fabsf(triangle.dzdx) + fabsf(triangle.dzdy));
+    triangles_.push_back(triangle);
+  }
+  stats_.triangles = unsigned(triangles_.size());
+}
+
+void OcclusionBuffer::Rasterize(ThreadPool* pool)
+{
+  auto start = std::chrono::steady_clock::now();
+  if (pool)
+    pool->ParallelFor(0, TILES_Y, 1, [this](unsigned tile_y, unsigned) { RasterizeTileRow_(tile_y); });
+  else
+  {
+    for (unsigned tile_y = 0; tile_y < TILES_Y; ++tile_y)
+      RasterizeTileRow_(tile_y);
+  }
+  Erode_();
+  stats_.rasterize_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void OcclusionBuffer::RasterizeTileRow_(unsigned tile_y)
+{
+  // each row of tiles is its own memory, so rows rasterize without sharing anything
+  float* row_depth = &depth_[size_t(tile_y) * TILES_X * TILE_WIDTH * TILE_HEIGHT];
+  std::fill(row_depth, row_depth + TILES_X * TILE_WIDTH * TILE_HEIGHT, 1.0f);
+  int band_min = int(tile_y * TILE_HEIGHT), band_max = band_min + int(TILE_HEIGHT) - 1;
+  const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+
+  for (const Triangle_& triangle : triangles_)
+  {
+    int min_y = std::max(triangle.min_y, band_min), max_y = std::min(triangle.max_y, band_max);
+    if (min_y > max_y)
+      continue;
+    int min_x = triangle.min_x & ~3;
+
+    __m128 edge_a[3], edge_b[3], edge_c[3];
+    for (int edge = 0; edge < 3; ++edge)
+    {
+      edge_a[edge] = _mm_set1_ps(triangle.edge_a[edge]);
+      edge_b[edge] = _mm_set1_ps(triangle.edge_b[edge]);
+      edge_c[edge] = _mm_set1_ps(triangle.edge_c[edge]);
+    }
+    __m128 dzdx = _mm_set1_ps(triangle.dzdx);
+
+    for (int y = min_y; y <= max_y; ++y)
+    {
+      __m128 pixel_y = _mm_set1_ps(float(y) + 0.5f);
+      // the parts of each function that are the same along the row
+      __m128 row_edge[3];
+      for (int edge = 0; edge < 3; ++edge)
+        row_edge[edge] = _mm_add_ps(_mm_mul_ps(edge_b[edge], pixel_y), edge_c[edge]);
+      __m128 row_z = _mm_set1_ps(triangle.z0 + triangle.dzdy * (float(y) + 0.5f));
+
+      for (int x = min_x; x <= triangle.max_x; x += 4)
+      {
+        __m128 pixel_x = _mm_add_ps(_mm_set1_ps(float(x)), lane_offsets);
+        __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a[0], pixel_x), row_edge[0]), _mm_setzero_ps());
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a[1], pixel_x), row_edge[1]), _mm_setzero_ps()));
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a[2], pixel_x), row_edge[2]), _mm_setzero_ps()));
+        if (!_mm_movemask_ps(inside))
+          continue;
+
+        float* pixels = &depth_[PixelIndex_(unsigned(x), unsigned(y))];
+        __m128 depth = _mm_loadu_ps(pixels);
+        __m128 z = _mm_add_ps(_mm_mul_ps(dzdx, pixel_x), row_z);
+        __m128 nearer = _mm_min_ps(depth, z);
+        _mm_storeu_ps(pixels, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, depth)));
+      }
+    }
+  }
+}
+
+void OcclusionBuffer::Erode_()
+{
+  // farthest of each pixel and its left and right neighbors, then of that and the rows above and below
+  for (unsigned y = 0; y < HEIGHT; ++y)
+    for (unsigned x = 0; x < WIDTH; ++x)
+    {
+      float farthest = depth_[PixelIndex_(x, y)];
+      if (x > 0)
+        farthest = std::max(farthest, depth_[PixelIndex_(x - 1, y)]);
+      if (x + 1 < WIDTH)
+        farthest = std::max(farthest, depth_[PixelIndex_(x + 1, y)]);
+      scratch_[PixelIndex_(x, y)] = farthest;
+    }
+  for (unsigned y = 0; y < HEIGHT; ++y)
+    for (unsigned x = 0; x < WIDTH; ++x)
+    {
+      float farthest = scratch_[PixelIndex_(x, y)];
+      if (y > 0)
+        farthest = std::max(farthest, scratch_[PixelIndex_(x, y - 1)]);
+      if (y + 1 < HEIGHT)
+        farthest = std::max(farthest, scratch_[PixelIndex_(x, y + 1)]);
+      depth_[PixelIndex_(x, y)] = farthest;
+    }
+  
+  for (unsigned tile = 0; tile < TILES_X * TILES_Y; ++tile)
+  {
+    const float* pixels = &depth_[size_t(tile) * TILE_WIDTH * TILE_HEIGHT];
+    __m128 farthest = _mm_loadu_ps(pixels);
+    for (unsigned i = 4; i < TILE_WIDTH * TILE_HEIGHT; i += 4)
+      farthest = _mm_max_ps(farthest, _mm_loadu_ps(pixels + i));
+    farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(1, 0, 3, 2)));
+    farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(2, 3, 0, 1)));
+    tile_max_[tile] = _mm_cvtss_f32(farthest);
+  }
+}
+
+bool OcclusionBuffer::IsVisible(const Aabb& bounds) const
+{
+  if (bounds.IsEmpty())
+    return false;
+
+  // screen rectangle and nearest depth of the corners
+  float min_x = float(WIDTH), min_y = float(HEIGHT), max_x = 0.0f, max_y = 0.0f, nearest = 1.0f;
+  for (int corner = 0; corner < 8; ++corner)
+  {
+    float clip[4];
+    if (!ToClip(view_projection_, corner & 1 ? bounds.max[0] : bounds.min[0], corner & 2 ? bounds.max[1] : bounds.min[1], corner & 4 ? bounds.max[2] : bounds.min[2], clip))
+      return true;
+    float x = (clip[0] / clip[3] * 0.5f + 0.5f) * WIDTH;
+    float y = (clip[1] / clip[3] * 0.5f + 0.5f) * HEIGHT;
+    min_x = std::min(min_x, x);
+    max_x = std::max(max_x, x);
+    min_y = std::min(min_y, y);
+    max_y = std::max(max_y, y);
+    nearest = std::min(nearest, clip[2] / clip[3]);
+  }
+
+  // boxes off the buffer are left to frustum culling
+  int x0 = int(floorf(min_x)), y0 = int(floorf(min_y)), x1 = int(ceilf(max_x)), y1 = int(ceilf(max_y));
+  if (x1 < 0 || y1 < 0 || x0 >= int(WIDTH) || y0 >= int(HEIGHT))
+    return true;
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, int(WIDTH) - 1);
+  y1 = std::min(y1, int(HEIGHT) - 1);
+
+  for (int tile_y = y0 / int(TILE_HEIGHT); tile_y <= y1 / int(TILE_HEIGHT); ++tile_y)
+    for (int tile_x = x0 / int(TILE_WIDTH); tile_x <= x1 / int(TILE_WIDTH); ++tile_x)
+    {
+      // every pixel of the tile is nearer than the box
+      if (tile_max_[tile_y * TILES_X + tile_x] < nearest)
+        continue;
+
+      int row_min = std::max(y0, tile_y * int(TILE_HEIGHT)), row_max = std::min(y1, (tile_y + 1) * int(TILE_HEIGHT) - 1);
+      int column_min = std::max(x0, tile_x * int(TILE_WIDTH)), column_max = std::min(x1, (tile_x + 1) * int(TILE_WIDTH) - 1);
+      for (int y = row_min; y <= row_max; ++y)
+      {
+        const float* row = &depth_[PixelIndex_(unsigned(tile_x) * TILE_WIDTH, unsigned(y))];
+        for (int x = column_min; x <= column_max; ++x)
+          if (row[x - tile_x * int(TILE_WIDTH)] >= nearest)
+            return true;
+      }
+    }
+  return false;
+}
+
+float OcclusionBuffer::Depth(unsigned x, unsigned y) const
+{
+  return depth_[PixelIndex_(x, y)];
+}
+
+unsigned OcclusionBuffer::PixelIndex_(unsigned x, unsigned y)
+{
+  unsigned tile = (y / TILE_HEIGHT) * TILES_X + x / TILE_WIDTH;
+  return tile * TILE_WIDTH * TILE_HEIGHT + (y % TILE_HEIGHT) * TILE_WIDTH + x % TILE_WIDTH;
+}
@@ -0,0 +1,118 @@
+/*! \file OcclusionBuffer.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains OcclusionBuffer, a small tiled depth buffer rasterized on the CPU to cull hidden objects.
+*/
+
+#pragma once
+
+#include "Bvh.h"
+
+#include <vector>
+
+class ThreadPool;
+
+/*! A low resolution depth buffer that occluder triangles are rasterized
+    into with SSE, 4 pixels at a time, so boxes behind them can be culled
+    before they reach the GPU. Nothing here touches GL.
+
+    The buffer is split into tiles, each a contiguous block of memory, and
+    every row of tiles is rasterized by its own task. Each tile also keeps
+    its farthest depth, so most boxes are decided without reading pixels.
+
+    Occluders are sampled at pixel centers, so neighboring triangles of a
+    mesh leave no cracks. Each pixel then takes the farthest depth of
+    itself and its 8 neighbors, which removes the partly covered pixels
+    along silhouettes. Triangles write the farthest depth they reach within
+    a pixel, and those crossing the near plane are skipped rather than
+    clipped. A box is then only culled behind solid occluders, except
+    through holes narrower than a buffer pixel.
+*/
+class OcclusionBuffer
+{
+  public:
+    //! Size of the buffer in pixels, stretched over the whole viewport.
+    static const unsigned WIDTH = 256;
+    static const unsigned HEIGHT = 144;
+    //! Size of a tile in pixels, TILE_WIDTH must be a multiple of 4.
+    static const unsigned TILE_WIDTH = 32;
+    static const unsigned TILE_HEIGHT = 16;
+    static const unsigned TILES_X = WIDTH / TILE_WIDTH;
+    static const unsigned TILES_Y = HEIGHT / TILE_HEIGHT;
+
+    //! Counts of the last frame.
+    struct Stats
+    {
+      unsigned occluders = 0;
+      //! Occluder triangles set up, not counting ones behind the near plane or off screen.
+      unsigned triangles = 0;
+      float rasterize_ms = 0.0f;
+    };
+
+    OcclusionBuffer();
+
+    /*! \brief Clears the buffer and the occluders, call once per frame before AddOccluder.
+        \param view_projection The column major camera matrix, 16 floats, copied.
+    */
+    void Begin(const float* view_projection);
+
+    /*! \brief Transforms an occluder's triangles to the screen, they are drawn by Rasterize.
+        \param model The column major model matrix, 16 floats.
+        \param positions Model space positions, 3 floats per vertex.
+        \param indices Triangle list indices into positions.
+        \param index_count The number of indices.
+    */
+    void AddOccluder(const float* model, const float* positions, const unsigned* indices, unsigned index_count);
+
+    /*! \brief Draws every occluder into the buffer, one task per row of tiles.
+        \param pool The workers to rasterize on, nullptr to rasterize on the calling thread.
+    */
+    void Rasterize(ThreadPool* pool);
+
+    /*! \brief Tests a box against the buffer, call after Rasterize.
+        \param bounds The world box.
+        \return False only if the box is certainly hidden behind occluders.
+    */
+    bool IsVisible(const Aabb& bounds) const;
+
+    //! \return Counts of the last Begin to Rasterize.
+    const Stats& LastStats() const { return stats_; }
+
+    //! \return The depth of a pixel, 1 where nothing was drawn, for debugging.
+    float Depth(unsigned x, unsigned y) const;
+
+  private:
+    //! A screen space triangle ready to rasterize.
+    struct Triangle_
+    {
+      //! Edge functions a * x + b * y + c, positive inside.
+      float edge_a[3];
+      float edge_b[3];
+      float edge_c[3];
+      //! Depth plane z0 + dzdx * x + dzdy * y, raised to the farthest depth within a pixel.
+      float z0;
+      float dzdx;
+      float dzdy;
+      //! Pixel bounds, clamped to the buffer.
+      int min_x, min_y, max_x, max_y;
+    };
+
+    //! \brief Rasterizes every triangle overlapping a row of tiles.
+    void RasterizeTileRow_(unsigned tile_y);
+    
+    //! \brief Spreads the farthest depth of each pixel's neighborhood into it, then updates the tile depths.
+    void Erode_();
+
+    //! \return The index of a pixel in depth_.
+    static unsigned PixelIndex_(unsigned x, unsigned y);
+
+    float view_projection_[16];
+    std::vector<Triangle_> triangles_;
+    //! Tile after tile, each TILE_WIDTH * TILE_HEIGHT row major.
+    std::vector<float> depth_;
+    //! The horizontal pass of Erode_.
+    std::vector<float> scratch_;
+    //! Farthest depth of each tile.
+    std::vector<float> tile_max_;
+    Stats stats_;
+};
@@ -0,0 +1,63 @@
+/*! \file RadixSort.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains RadixSortByKey, a stable LSD radix sort on 64-bit keys.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+/*! \brief Sorts values by their 64-bit key member, lowest first, in O(n).
+
+    One byte is sorted per pass. All eight histograms are built in a single
+    read of the data, and passes where every key shares the byte are
+    skipped, so keys with unused high bits cost fewer passes. Values with
+    equal keys keep their order.
+    \param data The values to sort, each with an unsigned long long key member.
+    \param scratch Room for count values, contents are overwritten.
+    \param count The number of values.
+*/
+template <typename T>
+void RadixSortByKey(T* data, T* scratch, size_t count)
+{
+  const unsigned PASSES = 8;
+  size_t histograms[PASSES][256];
+  memset(histograms, 0, sizeof(histograms));
+  for (size_t i = 0; i < count; ++i)
+  {
+    unsigned long long key = data[i].key;
+    for (unsigned pass = 0; pass < PASSES; ++pass)
+      ++histograms[pass][(key >> (pass * 8)) & 0xFF];
+  }
+  
+  T* from = data;
+  T* to = scratch;
+  for (unsigned pass = 0; pass < PASSES; ++pass)
+  {
+    size_t* histogram = histograms[pass];
+    unsigned shift = pass * 8;
+    if (count == 0 || histogram[(from[0].key >> shift) & 0xFF] == count)
+      continue;
+    
+    // turn counts into the first output slot of each byte value
+    size_t offset = 0;
+    for (unsigned digit = 0; digit < 256; ++digit)
+    {
+      size_t digit_count = histogram[digit];
+      histogram[digit] = offset;
+      offset += digit_count;
+    }
+    
+    for (size_t i = 0; i < count; ++i)
+      to[histogram[(from[i].key >> shift) & 0xFF]++] = from[i];
+    
+    T* swap = from;
+    from = to;
+    to = swap;
+  }
+  
+  if (from != data)
+    memcpy(static_cast<void*>(data), from, count * sizeof(T));
+}
@@ -0,0 +1,75 @@
+/*! \file AllocationCounters.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of AllocationCounters, replaces the global operator new and delete to count calls.
+*/
+
+#include "AllocationCounters.h"
+
+#include <cstdlib>
+#include <new>
+
+// zero initialized before any dynamic initialization, so counting is safe from the first allocation
+AllocationCounters ALLOCATION_COUNTERS;
+
+AllocationSnapshot AllocationSnapshot::Take()
+{
+  AllocationSnapshot snapshot;
+  snapshot.heap_allocations = ALLOCATION_COUNTERS.heap_allocations.load(std::memory_order_relaxed);
+  snapshot.heap_frees = ALLOCATION_COUNTERS.heap_frees.load(std::memory_order_relaxed);
+  snapshot.pool_allocations = ALLOCATION_COUNTERS.pool_allocations.load(std::memory_order_relaxed);
+  snapshot.pool_frees = ALLOCATION_COUNTERS.pool_frees.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+AllocationSnapshot AllocationSnapshot::operator-(const AllocationSnapshot& rhs) const
+{
+  AllocationSnapshot result;
+  result.heap_allocations = heap_allocations - rhs.heap_allocations;
+  result.heap_frees = heap_frees - rhs.heap_frees;
+  result.pool_allocations = pool_allocations - rhs.pool_allocations;
+  result.pool_frees = pool_frees - rhs.pool_frees;
+  return result;
+}
+
+// GLOBAL REPLACEMENTS START
+// the array, nothrow, and sized forms of the standard library all forward to these two
+
+void* operator new(std::size_t size)
+{
+  ALLOCATION_COUNTERS.heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* memory = malloc(size ? size : 1);
+  if (!memory)
+    throw std::bad_alloc();
+  return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+  if (!memory)
+    return;
+  ALLOCATION_COUNTERS.heap_frees.fetch_add(1, std::memory_order_relaxed);
+  free(memory);
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete[](void* memory) noexcept
+{
+  operator delete(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+  operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+  operator delete(memory);
+}
+
+// GLOBAL REPLACEMENTS END
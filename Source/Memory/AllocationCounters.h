@@ -0,0 +1,46 @@
+/*! \file AllocationCounters.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains counters for every heap allocation made by the program.
+*/
+
+#pragma once
+
+#include <atomic>
+
+/*! Totals since program start, maintained by the global operator new and
+    delete replacements in AllocationCounters.cpp and by PoolAllocator.
+*/
+struct AllocationCounters
+{
+  //! Calls to the global operator new.
+  std::atomic<unsigned long long> heap_allocations;
+  //! Calls to the global operator delete with a non-null pointer.
+  std::atomic<unsigned long long> heap_frees;
+  //! Blocks handed out by any PoolAllocator.
+  std::atomic<unsigned long long> pool_allocations;
+  //! Blocks returned to any PoolAllocator.
+  std::atomic<unsigned long long> pool_frees;
+};
+
+//! Plain copy of AllocationCounters, used to take per-frame differences.
+struct AllocationSnapshot
+{
+  unsigned long long heap_allocations = 0;
+  unsigned long long heap_frees = 0;
+  unsigned long long pool_allocations = 0;
+  unsigned long long pool_frees = 0;
+
+  /*! \brief Reads the current totals.
+      \return The totals at the time of the call.
+  */
+  static AllocationSnapshot Take();
+
+  /*! \brief Returns the counts that happened between rhs and this.
+      \param rhs The earlier snapshot.
+      \return The difference of each count.
+  */
+  AllocationSnapshot operator-(const AllocationSnapshot& rhs) const;
+};
+
+extern AllocationCounters ALLOCATION_COUNTERS;
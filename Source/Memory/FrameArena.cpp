@@ -0,0 +1,69 @@
+/*! \file FrameArena.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of FrameArena.
+*/
+
+#include "FrameArena.h"
+
+#include <new>
+
+FrameArena::FrameArena(size_t chunk_size) : chunk_size_(chunk_size), offset_(0), bytes_used_(0), last_frame_bytes_(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+  for (Chunk_& chunk : chunks_)
+    ::operator delete(chunk.memory);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+  size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+  if (chunks_.empty() || aligned + size > chunks_.back().size)
+  {
+    Grow_(size + alignment);
+    aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+  }
+  
+  // chunks come from operator new, so offsets aligned to max_align_t are aligned addresses
+  void* memory = chunks_.back().memory + aligned;
+  bytes_used_ += size;
+  offset_ = aligned + size;
+  return memory;
+}
+
+void FrameArena::Reset()
+{
+  // merge overflow chunks into one so next frame fits without growing
+  if (chunks_.size() > 1)
+  {
+    size_t total = Capacity();
+    for (Chunk_& chunk : chunks_)
+      ::operator delete(chunk.memory);
+    chunks_.clear();
+    Grow_(total);
+  }
+  
+  last_frame_bytes_ = bytes_used_;
+  bytes_used_ = 0;
+  offset_ = 0;
+}
+
+size_t FrameArena::Capacity() const
+{
+  size_t total = 0;
+  for (const Chunk_& chunk : chunks_)
+    total += chunk.size;
+  return total;
+}
+
+void FrameArena::Grow_(size_t size)
+{
+  Chunk_ chunk;
+  chunk.size = size > chunk_size_ ? size : chunk_size_;
+  chunk.memory = static_cast<char*>(::operator new(chunk.size));
+  chunks_.push_back(chunk);
+  offset_ = 0;
+}
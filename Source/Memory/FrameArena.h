@@ -0,0 +1,77 @@
+/*! \file FrameArena.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains FrameArena, a linear allocator released in bulk once per frame.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*! Bump allocator for data that only lives until the end of the frame.
+
+    Reset releases everything at once without running destructors. If a frame
+    overflowed into extra chunks, Reset replaces them with one chunk large
+    enough for that frame, so a steady-state frame makes no heap allocations.
+    Not thread safe.
+*/
+class FrameArena
+{
+  public:
+    /*! \brief Constructs an empty arena, nothing is allocated until needed.
+        \param chunk_size The minimum size of each chunk allocated from the heap.
+    */
+    FrameArena(size_t chunk_size = 64 * 1024);
+    
+    //! \brief Frees every chunk.
+    ~FrameArena();
+    
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    
+    /*! \brief Returns uninitialized memory valid until the next Reset.
+        \param size The number of bytes needed.
+        \param alignment The alignment needed, must be a power of two.
+        \return The memory, never nullptr.
+    */
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    
+    /*! \brief Allocates an uninitialized array valid until the next Reset.
+        \param count The number of elements.
+        \return The array, never nullptr.
+    */
+    template <typename T>
+    T* AllocateArray(size_t count)
+    {
+      return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+    
+    //! \brief Releases every allocation at once.
+    void Reset();
+    
+    //! \return Bytes handed out since the last Reset.
+    size_t BytesUsed() const { return bytes_used_; }
+    //! \return Bytes handed out between the last two Resets.
+    size_t LastFrameBytes() const { return last_frame_bytes_; }
+    //! \return Bytes in all chunks.
+    size_t Capacity() const;
+    
+  private:
+    struct Chunk_
+    {
+      char* memory;
+      size_t size;
+    };
+  
+    /*! \brief Allocates a chunk that fits at least the given size and makes it current.
+        \param size The number of bytes the chunk must fit.
+    */
+    void Grow_(size_t size);
+  
+    size_t chunk_size_;
+    size_t offset_;
+    size_t bytes_used_;
+    size_t last_frame_bytes_;
+    std::vector<Chunk_> chunks_;
+};
@@ -0,0 +1,155 @@
+/*! \file MappedFile.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of MappedFile class for Windows and POSIX.
+*/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), open_(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept : data_(rhs.data_), size_(rhs.size_), open_(rhs.open_)
+{
+  rhs.data_ = nullptr;
+  rhs.size_ = 0;
+  rhs.open_ = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    Close();
+    data_ = rhs.data_;
+    size_ = rhs.size_;
+    open_ = rhs.open_;
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+    rhs.open_ = false;
+  }
+  return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const char* path)
+{
+  Close();
+  
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size))
+  {
+    CloseHandle(file);
+    return false;
+  }
+  
+  open_ = true;
+  size_ = size_t(size.QuadPart);
+  if (size_ == 0)
+  {
+    // empty files cannot be mapped
+    CloseHandle(file);
+    return true;
+  }
+  
+  // the view keeps the mapping and file alive, so both handles can close now
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+  {
+    open_ = false;
+    size_ = 0;
+    return false;
+  }
+  data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  CloseHandle(mapping);
+  
+  if (!data_)
+  {
+    open_ = false;
+    size_ = 0;
+    return false;
+  }
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (data_)
+    UnmapViewOfFile(data_);
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+#else
+
+bool MappedFile::Open(const char* path)
+{
+  Close();
+  
+  int file = open(path, O_RDONLY);
+  if (file < 0)
+    return false;
+  
+  struct stat info;
+  if (fstat(file, &info) != 0)
+  {
+    close(file);
+    return false;
+  }
+  
+  open_ = true;
+  size_ = size_t(info.st_size);
+  if (size_ == 0)
+  {
+    // empty files cannot be mapped
+    close(file);
+    return true;
+  }
+  
+  void* view = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if (view == MAP_FAILED)
+  {
+    open_ = false;
+    size_ = 0;
+    return false;
+  }
+  madvise(view, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const char*>(view);
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (data_)
+    munmap(const_cast<char*>(data_), size_);
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*! \file MappedFile.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains MappedFile class, a read-only memory mapping of a whole file.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+//! Maps a file into the address space so it can be read without copying it.
+class MappedFile
+{
+  public:
+    //! \brief Constructs an empty mapping.
+    MappedFile();
+    
+    //! \brief Unmaps the file if one is open.
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    /*! \brief Takes over another mapping, leaving it empty.
+        \param rhs The mapping to take.
+    */
+    MappedFile(MappedFile&& rhs) noexcept;
+    
+    /*! \brief Closes this mapping and takes over another, leaving it empty.
+        \param rhs The mapping to take.
+        \return This MappedFile.
+    */
+    MappedFile& operator=(MappedFile&& rhs) noexcept;
+    
+    /*! \brief Maps a file, closing any previous mapping.
+        \param path The full path of the file.
+        \return False if the file could not be opened. An empty file opens but has no Data.
+    */
+    bool Open(const char* path);
+    
+    //! \brief Unmaps the file.
+    void Close();
+    
+    //! \return The start of the file, nullptr if nothing is mapped.
+    const char* Data() const { return data_; }
+    //! \return The size of the file in bytes.
+    size_t Size() const { return size_; }
+    //! \return True if a file is open.
+    bool IsOpen() const { return open_; }
+    
+  private:
+    const char* data_;
+    size_t size_;
+    bool open_;
+};
@@ -0,0 +1,112 @@
+/*! \file PoolAllocator.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of PoolAllocator and the size class pools.
+*/
+
+#include "PoolAllocator.h"
+#include "AllocationCounters.h"
+
+// every block must be able to hold the free list pointer and keep
+// the alignment operator new would have given it
+static const size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+PoolAllocator::PoolAllocator(size_t block_size, size_t blocks_per_chunk) :
+  block_size_((block_size + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1)), blocks_per_chunk_(blocks_per_chunk),
+  live_blocks_(0), free_head_(nullptr)
+{
+}
+
+PoolAllocator::~PoolAllocator()
+{
+  for (char* chunk : chunks_)
+    ::operator delete(chunk);
+}
+
+void* PoolAllocator::Allocate()
+{
+  if (!free_head_)
+    Grow_();
+  
+  void* block = free_head_;
+  free_head_ = *static_cast<void**>(block);
+  ++live_blocks_;
+  ALLOCATION_COUNTERS.pool_allocations.fetch_add(1, std::memory_order_relaxed);
+  return block;
+}
+
+void PoolAllocator::Free(void* block)
+{
+  if (!block)
+    return;
+  
+  *static_cast<void**>(block) = free_head_;
+  free_head_ = block;
+  --live_blocks_;
+  ALLOCATION_COUNTERS.pool_frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PoolAllocator::Grow_()
+{
+  char* chunk = static_cast<char*>(::operator new(block_size_ * blocks_per_chunk_));
+  chunks_.push_back(chunk);
+  
+  for (size_t j = blocks_per_chunk_; j-- > 0;)
+  {
+    void* block = chunk + j * block_size_;
+    *static_cast<void**>(block) = free_head_;
+    free_head_ = block;
+  }
+}
+
+// SIZE CLASSES START
+
+static const size_t SIZE_CLASS_COUNT = 7;
+static const size_t SMALLEST_SIZE_CLASS = 16;
+
+// function local so pools exist before any static object allocates from them
+static PoolAllocator* SizeClasses()
+{
+  static PoolAllocator* pools = []()
+  {
+    // intentionally never destroyed, pooled objects may outlive static destruction
+    PoolAllocator* pools = static_cast<PoolAllocator*>(::operator new(sizeof(PoolAllocator) * SIZE_CLASS_COUNT));
+    for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+      new (pools + i) PoolAllocator(SMALLEST_SIZE_CLASS << i);
+    return pools;
+  }();
+  return pools;
+}
+
+static size_t SizeClassIndex(size_t size)
+{
+  size_t index = 0;
+  while ((SMALLEST_SIZE_CLASS << index) < size)
+    ++index;
+  return index;
+}
+
+namespace Pool
+{
+  void* Allocate(size_t size)
+  {
+    if (size > MAX_BLOCK_SIZE)
+      return ::operator new(size);
+    return SizeClasses()[SizeClassIndex(size)].Allocate();
+  }
+  
+  void Free(void* memory, size_t size)
+  {
+    if (size > MAX_BLOCK_SIZE)
+      ::operator delete(memory);
+    else
+      SizeClasses()[SizeClassIndex(size)].Free(memory);
+  }
+  
+  const PoolAllocator* SizeClass(size_t index)
+  {
+    return index < SIZE_CLASS_COUNT ? &SizeClasses()[index] : nullptr;
+  }
+}
+
+// SIZE CLASSES END
@@ -0,0 +1,120 @@
+/*! \file PoolAllocator.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains PoolAllocator, a fixed-size-block allocator, and the pooled helpers built on it.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/*! Hands out fixed size blocks carved from large chunks.
+
+    Freed blocks go on an intrusive free list and are recycled before a new
+    chunk is allocated, so once a pool has grown to its peak usage it never
+    touches the heap again. Not thread safe, pools are used from the main thread.
+*/
+class PoolAllocator
+{
+  public:
+    /*! \brief Constructs an empty pool, no chunks are allocated until needed.
+        \param block_size The size of each block, rounded up to hold a pointer.
+        \param blocks_per_chunk The number of blocks allocated from the heap at once.
+    */
+    PoolAllocator(size_t block_size, size_t blocks_per_chunk = 256);
+    
+    //! \brief Frees every chunk, all blocks become invalid.
+    ~PoolAllocator();
+    
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+    
+    /*! \brief Returns an unused block, allocating a chunk if none are free.
+        \return A block of at least BlockSize bytes, aligned for any fundamental type.
+    */
+    void* Allocate();
+    
+    /*! \brief Returns a block to the free list.
+        \param block A block from Allocate of this pool, may be nullptr.
+    */
+    void Free(void* block);
+    
+    //! \return The size of each block.
+    size_t BlockSize() const { return block_size_; }
+    //! \return The number of blocks currently handed out.
+    size_t LiveBlocks() const { return live_blocks_; }
+    //! \return The number of blocks in all chunks.
+    size_t Capacity() const { return chunks_.size() * blocks_per_chunk_; }
+    //! \return The number of chunks allocated from the heap.
+    size_t Chunks() const { return chunks_.size(); }
+    
+  private:
+    //! \brief Allocates a new chunk and threads its blocks onto the free list.
+    void Grow_();
+  
+    size_t block_size_;
+    size_t blocks_per_chunk_;
+    size_t live_blocks_;
+    void* free_head_;
+    std::vector<char*> chunks_;
+};
+
+namespace Pool
+{
+  //! Largest size served by the size class pools, anything larger goes to the heap.
+  const size_t MAX_BLOCK_SIZE = 1024;
+
+  /*! \brief Allocates from the smallest size class pool that fits.
+      \param size The number of bytes needed.
+      \return The memory, never nullptr.
+  */
+  void* Allocate(size_t size);
+  
+  /*! \brief Returns memory from Allocate to its size class pool.
+      \param memory The memory to return, may be nullptr.
+      \param size The size given to Allocate.
+  */
+  void Free(void* memory, size_t size);
+  
+  /*! \brief Visits each size class pool, used to display statistics.
+      \param index The size class, pools are returned smallest first.
+      \return The pool, or nullptr when index is past the last size class.
+  */
+  const PoolAllocator* SizeClass(size_t index);
+}
+
+/*! Standard library allocator that serves single element allocations from
+    the size class pools, meant for node based containers like unordered_set.
+    Array allocations such as bucket tables go to the heap.
+*/
+template <typename T>
+struct PoolStlAllocator
+{
+  typedef T value_type;
+
+  PoolStlAllocator() {}
+  template <typename U>
+  PoolStlAllocator(const PoolStlAllocator<U>&) {}
+
+  T* allocate(size_t count)
+  {
+    if (count == 1 && sizeof(T) <= Pool::MAX_BLOCK_SIZE)
+      return static_cast<T*>(Pool::Allocate(sizeof(T)));
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T* memory, size_t count)
+  {
+    if (count == 1 && sizeof(T) <= Pool::MAX_BLOCK_SIZE)
+      Pool::Free(memory, sizeof(T));
+    else
+      ::operator delete(memory);
+  }
+
+  template <typename U>
+  bool operator==(const PoolStlAllocator<U>&) const { return true; }
+  template <typename U>
+  bool operator!=(const PoolStlAllocator<U>&) const { return false; }
+};
@@ -0,0 +1,211 @@
+/*! \file SlotMap.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains SlotMap class template, a generational handle map with packed storage.
+*/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+
+/*! Stores values contiguously and hands out stable 32-bit handles to them.
+
+    A handle is a slot index in the low INDEX_BITS bits and that slot's
+    generation in the remaining high bits. Removing a value swaps the last
+    value into its place and bumps the slot generation, so iteration is always
+    a linear walk over packed data and old handles are detected as stale.
+*/
+template <typename T>
+class SlotMap
+{
+  public:
+    //! Number of handle bits used by the slot index.
+    static const unsigned INDEX_BITS = 22;
+    //! Mask of the slot index portion of a handle.
+    static const unsigned INDEX_MASK = (1u << INDEX_BITS) - 1;
+    //! Mask of the generation once shifted down from a handle.
+    static const unsigned GENERATION_MASK = ~0u >> INDEX_BITS;
+    //! A handle that will never be returned by Emplace.
+    static const unsigned INVALID_HANDLE = ~0u;
+    //! The maximum number of values that may be stored at once.
+    static const unsigned MAX_SIZE = INDEX_MASK;
+
+    typedef typename std::vector<T>::iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    //! \brief Default constructor, performs no allocations.
+    SlotMap() : free_head_(INDEX_MASK)
+    {
+    }
+
+    /*! \brief Returns the handle the next call to Emplace will return.
+        \return The handle of the next value to be emplaced.
+    */
+    unsigned NextHandle() const
+    {
+      if (free_head_ != INDEX_MASK)
+        return Handle_(free_head_, slots_[free_head_].generation);
+      return Handle_(unsigned(slots_.size()), 0);
+    }
+
+    /*! \brief Constructs a value in place at the end of the packed storage.
+        \param args The arguments forwarded to the constructor of T.
+        \return The handle of the new value, or INVALID_HANDLE if the map is full.
+    */
+    template <typename... Args>
+    unsigned Emplace(Args&&... args)
+    {
+      unsigned slot = free_head_;
+      if (slot != INDEX_MASK)
+        free_head_ = slots_[slot].dense;
+      else
+      {
+        if (slots_.size() >= MAX_SIZE)
+          return INVALID_HANDLE;
+        slot = unsigned(slots_.size());
+        slots_.push_back(Slot_{0, 0});
+      }
+
+      data_.emplace_back(std::forward<Args>(args)...);
+      slot_of_.push_back(slot);
+      slots_[slot].dense = unsigned(data_.size() - 1);
+      return Handle_(slot, slots_[slot].generation);
+    }
+
+    /*! \brief Removes a value, moving the last value into its place.
+        \param handle The handle of the value to remove.
+        \return False if the handle was stale or never valid.
+    */
+    bool Remove(unsigned handle)
+    {
+      if (!Contains(handle))
+        return false;
+
+      unsigned slot = handle & INDEX_MASK;
+      unsigned dense = slots_[slot].dense;
+      unsigned last = unsigned(data_.size() - 1);
+      if (dense != last)
+      {
+        data_[dense] = std::move(data_[last]);
+        slot_of_[dense] = slot_of_[last];
+        slots_[slot_of_[dense]].dense = dense;
+      }
+      data_.pop_back();
+      slot_of_.pop_back();
+
+      // bump the generation so the removed handle goes stale
+      slots_[slot].generation = (slots_[slot].generation + 1) & GENERATION_MASK;
+      slots_[slot].dense = free_head_;
+      free_head_ = slot;
+      return true;
+    }
+
+    /*! \brief Checks if a handle refers to a live value.
+        \param handle The handle to check.
+        \return True if the handle is live.
+    */
+    bool Contains(unsigned handle) const
+    {
+      unsigned slot = handle & INDEX_MASK;
+      if (slot >= slots_.size() || slots_[slot].generation != (handle >> INDEX_BITS))
+        return false;
+      // free slots store the free list in dense, so confirm the back reference
+      unsigned dense = slots_[slot].dense;
+      return dense < slot_of_.size() && slot_of_[dense] == slot;
+    }
+
+    /*! \brief Returns the value for a handle.
+        \param handle The handle of the value.
+        \return A pointer to the value, or nullptr if the handle is stale.
+    */
+    T* Get(unsigned handle)
+    {
+      return Contains(handle) ? &data_[slots_[handle & INDEX_MASK].dense] : nullptr;
+    }
+
+    //! \copydoc Get
+    const T* Get(unsigned handle) const
+    {
+      return Contains(handle) ? &data_[slots_[handle & INDEX_MASK].dense] : nullptr;
+    }
+
+    /*! \brief Returns the packed index of a live handle, for indexing parallel arrays.
+        \param handle The handle of the value, must be live.
+        \return The index of the value in the packed storage.
+    */
+    unsigned IndexOf(unsigned handle) const
+    {
+      return slots_[handle & INDEX_MASK].dense;
+    }
+
+    /*! \brief Returns the handle of the value at a packed index.
+        \param index The packed index, must be less than Size.
+        \return The handle of the value.
+    */
+    unsigned HandleAt(unsigned index) const
+    {
+      unsigned slot = slot_of_[index];
+      return Handle_(slot, slots_[slot].generation);
+    }
+
+    /*! \brief Reserves room for values so Emplace does not reallocate.
+        \param count The total number of values to make room for.
+    */
+    void Reserve(unsigned count)
+    {
+      data_.reserve(count);
+      slot_of_.reserve(count);
+      slots_.reserve(count);
+    }
+
+    //! \brief Removes all values, all existing handles go stale.
+    void Clear()
+    {
+      while (!data_.empty())
+        Remove(HandleAt(unsigned(data_.size() - 1)));
+    }
+
+    //! \return The number of live values.
+    unsigned Size() const { return unsigned(data_.size()); }
+    //! \return The number of values that fit without reallocating.
+    unsigned Capacity() const { return unsigned(data_.capacity()); }
+    //! \return True if there are no live values.
+    bool Empty() const { return data_.empty(); }
+
+    //! \return The packed value storage.
+    T* Data() { return data_.data(); }
+    //! \copydoc Data
+    const T* Data() const { return data_.data(); }
+
+    T& operator[](unsigned index) { return data_[index]; }
+    const T& operator[](unsigned index) const { return data_[index]; }
+
+    iterator begin() { return data_.begin(); }
+    iterator end() { return data_.end(); }
+    const_iterator begin() const { return data_.begin(); }
+    const_iterator end() const { return data_.end(); }
+
+  private:
+    struct Slot_
+    {
+      //! Packed index when live, next free slot when free.
+      unsigned dense;
+      //! Incremented each time the slot's value is removed.
+      unsigned generation;
+    };
+
+    static unsigned Handle_(unsigned slot, unsigned generation)
+    {
+      return (generation << INDEX_BITS) | slot;
+    }
+
+    //! Packed values.
+    std::vector<T> data_;
+    //! The slot each packed value belongs to.
+    std::vector<unsigned> slot_of_;
+    //! Indirection from handle to packed index.
+    std::vector<Slot_> slots_;
+    //! Head of the free slot list, INDEX_MASK if empty.
+    unsigned free_head_;
+};
@@ -0,0 +1,131 @@
+/*! \file MpscQueue.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains MpscQueue, a bounded lock-free multi-producer single-consumer queue.
+*/
+
+#pragma once
+
+#include <atomic>
+
+/*! Fixed capacity ring of cells, each with a sequence number that says whose
+    turn it is to touch the cell.
+
+    Any number of threads may push, producers claim cells with a single CAS on
+    the enqueue position and never block each other while filling them. Only
+    one thread may pop. Pushing never allocates, when the ring is full the push
+    fails instead of waiting, since the consumer may be the thread pushing.
+*/
+template <typename T, unsigned CAPACITY>
+class MpscQueue
+{
+  static_assert(CAPACITY > 1 && (CAPACITY & (CAPACITY - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+  public:
+    //! \brief Constructs an empty queue, all storage is inline.
+    MpscQueue() : enqueue_pos_(0), dequeue_pos_(0)
+    {
+      for (unsigned i = 0; i < CAPACITY; ++i)
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    
+    /*! \brief Pushes one value, callable from any thread.
+        \param value The value to copy in.
+        \return False if the queue was full.
+    */
+    bool Push(const T& value)
+    {
+      return PushBulk(1, [&value](T& cell, unsigned) { cell = value; }) == 1;
+    }
+    
+    /*! \brief Claims up to count consecutive cells with one CAS and fills them in order.
+        \param count The number of values to push.
+        \param fill Called as fill(T& cell, unsigned i) for each claimed cell.
+        \return The number of values pushed, less than count only if the queue filled up.
+    */
+    template <typename Fill>
+    unsigned PushBulk(unsigned count, Fill fill)
+    {
+      unsigned pushed = 0;
+      while (pushed < count)
+      {
+        unsigned claim = count - pushed < CAPACITY ? count - pushed : CAPACITY;
+        unsigned pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+          // the consumer frees cells in order, so if the last cell of the
+          // claim is free every cell before it is as well
+          unsigned last = pos + claim - 1;
+          unsigned sequence = cells_[last & (CAPACITY - 1)].sequence.load(std::memory_order_acquire);
+          int diff = int(sequence - last);
+          if (diff == 0)
+          {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + claim, std::memory_order_relaxed))
+              break;
+          }
+          else if (diff < 0)
+          {
+            // not enough room, try a smaller claim
+            if (claim == 1)
+              return pushed;
+            claim /= 2;
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+          }
+          else
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+        
+        for (unsigned i = 0; i < claim; ++i)
+        {
+          Cell_& cell = cells_[(pos + i) & (CAPACITY - 1)];
+          fill(cell.value, pushed + i);
+          cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        pushed += claim;
+      }
+      return pushed;
+    }
+    
+    /*! \brief Pops values in push order, callable only from the consumer thread.
+        \param out Array the values are moved into.
+        \param max The size of out.
+        \return The number of values popped, stops early at a cell still being filled.
+    */
+    unsigned Pop(T* out, unsigned max)
+    {
+      unsigned popped = 0;
+      unsigned pos = dequeue_pos_.load(std::memory_order_relaxed);
+      while (popped < max)
+      {
+        Cell_& cell = cells_[pos & (CAPACITY - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+          break;
+        out[popped++] = cell.value;
+        cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+        ++pos;
+      }
+      dequeue_pos_.store(pos, std::memory_order_relaxed);
+      return popped;
+    }
+    
+    //! \return An upper bound on the values ready to pop, exact if producers are idle.
+    unsigned SizeApprox() const
+    {
+      return enqueue_pos_.load(std::memory_order_acquire) - dequeue_pos_.load(std::memory_order_relaxed);
+    }
+    
+  private:
+    struct Cell_
+    {
+      std::atomic<unsigned> sequence;
+      T value;
+    };
+    
+    // keep producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<unsigned> enqueue_pos_;
+    alignas(64) std::atomic<unsigned> dequeue_pos_;
+    alignas(64) Cell_ cells_[CAPACITY];
+};
@@ -0,0 +1,169 @@
+/*! \file TaskGraph.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of TaskGraph.
+*/
+
+#include "TaskGraph.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+// HELPER FUNCTIONS START
+
+//! Marks a resource with no writer yet.
+static const unsigned NO_STAGE = ~0u;
+
+//! Adds a dependency once.
+static void AddUnique(std::vector<unsigned>& list, unsigned value)
+{
+  if (std::find(list.begin(), list.end(), value) == list.end())
+    list.push_back(value);
+}
+
+// HELPER FUNCTIONS END
+
+TaskGraph::TaskGraph() : last_writer_(MAX_RESOURCES, NO_STAGE), readers_(MAX_RESOURCES), remaining_(0), pool_(nullptr), run_ms_(0.0f), critical_ms_(0.0f)
+{
+}
+
+unsigned TaskGraph::AddStage(const char* name, Affinity affinity, unsigned reads, unsigned writes, std::function<void()> work)
+{
+  unsigned index = unsigned(stages_.size());
+  Stage_ stage;
+  stage.name = name;
+  stage.affinity = affinity;
+  stage.work = std::move(work);
+
+  for (unsigned resource = 0; resource < MAX_RESOURCES; ++resource)
+  {
+    unsigned bit = 1u << resource;
+    if (!((reads | writes) & bit))
+      continue;
+
+    // read after write and write after write
+    if (last_writer_[resource] != NO_STAGE)
+      AddUnique(stage.dependencies, last_writer_[resource]);
+    if (writes & bit)
+    {
+      // write after read, earlier readers must see the old value
+      for (unsigned reader : readers_[resource])
+        AddUnique(stage.dependencies, reader);
+      readers_[resource].clear();
+      last_writer_[resource] = index;
+    }
+    else
+      readers_[resource].push_back(index);
+  }
+
+  for (unsigned dependency : stage.dependencies)
+    stages_[dependency].dependents.push_back(index);
+  stages_.push_back(std::move(stage));
+  waiting_ = std::vector<std::atomic<unsigned>>(stages_.size());
+  return index;
+}
+
+void TaskGraph::Run(ThreadPool* pool)
+{
+  run_start_ = std::chrono::steady_clock::now();
+  pool_ = pool;
+
+  if (!pool)
+  {
+    // declared order already satisfies every dependency
+    for (unsigned stage = 0; stage < stages_.size(); ++stage)
+      Execute_(stage, true);
+  }
+  else
+  {
+    remaining_.store(unsigned(stages_.size()), std::memory_order_relaxed);
+    for (unsigned stage = 0; stage < stages_.size(); ++stage)
+      waiting_[stage].store(unsigned(stages_[stage].dependencies.size()), std::memory_order_relaxed);
+    for (unsigned stage = 0; stage < stages_.size(); ++stage)
+      if (stages_[stage].dependencies.empty())
+        Schedule_(stage);
+
+    // main thread stages come first, then help the workers
+    while (remaining_.load(std::memory_order_acquire))
+    {
+      unsigned stage = NO_STAGE;
+      {
+        std::lock_guard<std::mutex> lock(main_mutex_);
+        if (!main_ready_.empty())
+        {
+          // lowest index first, the declared order
+          auto first = std::min_element(main_ready_.begin(), main_ready_.end());
+          stage = *first;
+          main_ready_.erase(first);
+        }
+      }
+      if (stage != NO_STAGE)
+        Execute_(stage, true);
+      else if (!pool->RunOne())
+        std::this_thread::yield();
+    }
+  }
+
+  run_ms_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - run_start_).count();
+  FindCriticalPath_();
+}
+
+void TaskGraph::Schedule_(unsigned stage)
+{
+  if (stages_[stage].affinity == MainThread)
+  {
+    std::lock_guard<std::mutex> lock(main_mutex_);
+    main_ready_.push_back(stage);
+    return;
+  }
+  pool_->Submit([this, stage]() { Execute_(stage, false); });
+}
+
+void TaskGraph::Execute_(unsigned stage, bool on_main_thread)
+{
+  Stage_& current = stages_[stage];
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  current.work();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  current.timing.start_ms = std::chrono::duration<float, std::milli>(start - run_start_).count();
+  current.timing.duration_ms = std::chrono::duration<float, std::milli>(end - start).count();
+  current.timing.on_main_thread = on_main_thread;
+
+  if (!pool_)
+    return;
+  for (unsigned dependent : current.dependents)
+    if (waiting_[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+      Schedule_(dependent);
+  remaining_.fetch_sub(1, std::memory_order_release);
+}
+
+void TaskGraph::FindCriticalPath_()
+{
+  // longest chain of durations, dependencies always have lower indices
+  finish_.assign(stages_.size(), 0.0f);
+  previous_.assign(stages_.size(), NO_STAGE);
+  unsigned last = NO_STAGE;
+  for (unsigned stage = 0; stage < stages_.size(); ++stage)
+  {
+    float longest = 0.0f;
+    for (unsigned dependency : stages_[stage].dependencies)
+      if (previous_[stage] == NO_STAGE || finish_[dependency] > longest)
+      {
+        longest = finish_[dependency];
+        previous_[stage] = dependency;
+      }
+    finish_[stage] = longest + stages_[stage].timing.duration_ms;
+    stages_[stage].timing.critical = false;
+    if (last == NO_STAGE || finish_[stage] > finish_[last])
+      last = stage;
+  }
+
+  critical_path_.clear();
+  critical_ms_ = last == NO_STAGE ? 0.0f : finish_[last];
+  for (unsigned stage = last; stage != NO_STAGE; stage = previous_[stage])
+  {
+    critical_path_.push_back(stage);
+    stages_[stage].timing.critical = true;
+  }
+  std::reverse(critical_path_.begin(), critical_path_.end());
+}
@@ -0,0 +1,122 @@
+/*! \file TaskGraph.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains TaskGraph class, stages of a frame ordered by the data they read and write.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+/*! A fixed set of stages run once per Run, each declaring the resources it
+    reads and writes as bits of a mask.
+
+    Stages are declared in the order they would run one after another, and
+    the graph keeps that meaning: a stage waits for the last earlier stage
+    writing anything it touches, and a writer also waits for every earlier
+    reader since that write. Anything else may overlap. Stages tied to the
+    main thread, such as GL calls, run only on the thread calling Run,
+    which helps with the others while it waits.
+
+    Each Run times every stage and reports the critical path, the chain of
+    dependent stages that bounds the frame however many threads there are.
+*/
+class TaskGraph
+{
+  public:
+    //! Resources are bits of an unsigned mask.
+    static const unsigned MAX_RESOURCES = 32;
+
+    //! Where a stage may run.
+    enum Affinity { AnyThread, MainThread };
+
+    //! When a stage ran in the last Run, relative to the start of it.
+    struct Timing
+    {
+      float start_ms = 0.0f;
+      float duration_ms = 0.0f;
+      bool on_main_thread = false;
+      bool critical = false;
+    };
+
+    TaskGraph();
+
+    /*! \brief Declares a stage, after every stage it should follow.
+        \param name Shown in reports, copied.
+        \param affinity Where the stage may run.
+        \param reads Mask of the resources the stage reads.
+        \param writes Mask of the resources the stage writes, which it may also read.
+        \param work The stage.
+        \return The index of the stage.
+    */
+    unsigned AddStage(const char* name, Affinity affinity, unsigned reads, unsigned writes, std::function<void()> work);
+
+    /*! \brief Runs every stage once, returning when all are done. Call from the main thread.
+        \param pool Workers to overlap stages on, nullptr runs every stage in declared order on the calling thread.
+    */
+    void Run(ThreadPool* pool);
+
+    //! \return The number of stages.
+    unsigned StageCount() const { return unsigned(stages_.size()); }
+    //! \return The name of a stage.
+    const char* StageName(unsigned stage) const { return stages_[stage].name.c_str(); }
+    //! \return The stages a stage waits for.
+    const std::vector<unsigned>& Dependencies(unsigned stage) const { return stages_[stage].dependencies; }
+    //! \return When a stage ran in the last Run.
+    const Timing& LastTiming(unsigned stage) const { return stages_[stage].timing; }
+
+    //! \return The time the last Run took.
+    float LastRunMs() const { return run_ms_; }
+    //! \return The summed durations along the critical path of the last Run.
+    float CriticalPathMs() const { return critical_ms_; }
+    //! \return The stages on the critical path of the last Run, first to last.
+    const std::vector<unsigned>& CriticalPath() const { return critical_path_; }
+
+  private:
+    struct Stage_
+    {
+      std::string name;
+      Affinity affinity;
+      std::function<void()> work;
+      std::vector<unsigned> dependencies;
+      std::vector<unsigned> dependents;
+      Timing timing;
+    };
+
+    //! \brief Hands a stage whose dependencies are done to the pool or the main thread.
+    void Schedule_(unsigned stage);
+
+    //! \brief Runs a stage, times it, then schedules the dependents it was the last wait of.
+    void Execute_(unsigned stage, bool on_main_thread);
+
+    //! \brief Finds the critical path from the timings of the last Run.
+    void FindCriticalPath_();
+
+    std::vector<Stage_> stages_;
+    //! The last stage writing each resource, and the stages reading it since.
+    std::vector<unsigned> last_writer_;
+    std::vector<std::vector<unsigned>> readers_;
+
+    //! Dependencies left of each stage during Run.
+    std::vector<std::atomic<unsigned>> waiting_;
+    std::atomic<unsigned> remaining_;
+    ThreadPool* pool_;
+    //! Main thread stages ready to run.
+    std::vector<unsigned> main_ready_;
+    std::mutex main_mutex_;
+
+    std::chrono::steady_clock::time_point run_start_;
+    float run_ms_;
+    float critical_ms_;
+    std::vector<unsigned> critical_path_;
+    //! Scratch for FindCriticalPath_, kept so Run allocates nothing after the first.
+    std::vector<float> finish_;
+    std::vector<unsigned> previous_;
+};
@@ -0,0 +1,256 @@
+/*! \file ThreadPool.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of ThreadPool.
+*/
+
+#include "ThreadPool.h"
+
+// HELPER FUNCTIONS START
+
+//! The pool the calling thread works for and its slot, set once on each worker.
+static thread_local const ThreadPool* current_pool = nullptr;
+static thread_local unsigned current_slot = 0;
+
+//! Times an empty worker yields before going to sleep.
+static const unsigned SPIN_YIELDS = 16;
+
+// HELPER FUNCTIONS END
+
+ThreadPool::ThreadPool(unsigned thread_count) : owner_(std::this_thread::get_id()), shared_count_(0), queued_(0), sleeping_(0), stopping_(false)
+{
+  if (thread_count == 0)
+  {
+    unsigned hardware = std::thread::hardware_concurrency();
+    thread_count = hardware > 1 ? hardware - 1 : 1;
+  }
+
+  slot_count_ = thread_count + 1;
+  slots_.reset(new Slot_[slot_count_]);
+  stats_start_ = std::chrono::steady_clock::now();
+
+  workers_.reserve(thread_count);
+  for (unsigned i = 0; i < thread_count; ++i)
+    workers_.emplace_back(&ThreadPool::WorkerLoop_, this, i + 1);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+
+  for (std::thread& worker : workers_)
+    worker.join();
+
+  for (unsigned i = 0; i < slot_count_; ++i)
+    for (Task_* task : slots_[i].free_tasks)
+      delete task;
+  for (Task_* task : free_tasks_)
+    delete task;
+}
+
+void ThreadPool::Submit(std::function<void()> task, TaskCounter* counter)
+{
+  if (counter)
+    counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+  // counted before it can be taken, so queued_ never drops below the tasks waiting.
+  // sleepers count themselves before checking queued_, so one of the two sides sees the other
+  queued_.fetch_add(1, std::memory_order_seq_cst);
+  unsigned slot = CurrentSlot_();
+  Task_* queued = AllocateTask_(slot);
+  queued->function = std::move(task);
+  queued->counter = counter;
+  if (slot == NO_SLOT_ || !slots_[slot].tasks.Push(queued))
+  {
+    std::lock_guard<std::mutex> lock(shared_mutex_);
+    shared_.push_back(queued);
+    shared_count_.fetch_add(1, std::memory_order_release);
+  }
+
+  if (sleeping_.load(std::memory_order_seq_cst))
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    wake_.notify_one();
+  }
+}
+
+void ThreadPool::Wait(TaskCounter& counter)
+{
+  unsigned slot = CurrentSlot_();
+  while (counter.pending.load(std::memory_order_acquire) != 0)
+  {
+    if (Task_* task = Take_(slot))
+      Run_(task, slot);
+    else
+      std::this_thread::yield();
+  }
+}
+
+bool ThreadPool::RunOne()
+{
+  unsigned slot = CurrentSlot_();
+  Task_* task = Take_(slot);
+  if (!task)
+    return false;
+  Run_(task, slot);
+  return true;
+}
+
+void ThreadPool::TakeStats(std::vector<WorkerStats>& stats)
+{
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  double elapsed_ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(now - stats_start_).count());
+  stats_start_ = now;
+
+  stats.resize(slot_count_);
+  for (unsigned i = 0; i < slot_count_; ++i)
+  {
+    Slot_& slot = slots_[i];
+    double busy_ns = double(slot.busy_ns.exchange(0, std::memory_order_relaxed));
+    stats[i].utilization = elapsed_ns > 0.0 ? float(std::min(busy_ns / elapsed_ns, 1.0)) : 0.0f;
+    stats[i].tasks = slot.task_count.exchange(0, std::memory_order_relaxed);
+    stats[i].steals = slot.steals.exchange(0, std::memory_order_relaxed);
+  }
+}
+
+void ThreadPool::WorkerLoop_(unsigned slot)
+{
+  current_pool = this;
+  current_slot = slot;
+
+  unsigned idle = 0;
+  for (;;)
+  {
+    if (Task_* task = Take_(slot))
+    {
+      Run_(task, slot);
+      idle = 0;
+      continue;
+    }
+
+    if (++idle < SPIN_YIELDS)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleeping_.fetch_add(1, std::memory_order_seq_cst);
+    wake_.wait(lock, [this]() { return stopping_ || queued_.load(std::memory_order_seq_cst) != 0; });
+    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    // every queued task has been taken, woken only to exit
+    if (stopping_ && queued_.load(std::memory_order_seq_cst) == 0)
+      return;
+    idle = 0;
+  }
+}
+
+unsigned ThreadPool::CurrentSlot_() const
+{
+  if (current_pool == this)
+    return current_slot;
+  return std::this_thread::get_id() == owner_ ? 0 : NO_SLOT_;
+}
+
+ThreadPool::Task_* ThreadPool::Take_(unsigned slot)
+{
+  Task_* task = nullptr;
+  if (slot != NO_SLOT_)
+    task = slots_[slot].tasks.Pop();
+
+  if (!task && shared_count_.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(shared_mutex_);
+    if (!shared_.empty())
+    {
+      task = shared_.front();
+      shared_.pop_front();
+      shared_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  // steal from the others, starting after our own slot so thieves spread out
+  unsigned start = slot == NO_SLOT_ ? 0 : slot + 1;
+  for (unsigned i = 0; !task && i < slot_count_; ++i)
+  {
+    unsigned victim = (start + i) % slot_count_;
+    if (victim == slot)
+      continue;
+    task = slots_[victim].tasks.Steal();
+    if (task && slot != NO_SLOT_)
+      slots_[slot].steals.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (task)
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+  return task;
+}
+
+void ThreadPool::Run_(Task_* task, unsigned slot)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  task->function();
+  if (task->counter)
+    task->counter->pending.fetch_sub(1, std::memory_order_release);
+  ReleaseTask_(task, slot);
+
+  if (slot == NO_SLOT_)
+    return;
+  unsigned long long busy_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  slots_[slot].busy_ns.fetch_add(busy_ns, std::memory_order_relaxed);
+  slots_[slot].task_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+ThreadPool::Task_* ThreadPool::AllocateTask_(unsigned slot)
+{
+  if (slot != NO_SLOT_ && !slots_[slot].free_tasks.empty())
+  {
+    Task_* task = slots_[slot].free_tasks.back();
+    slots_[slot].free_tasks.pop_back();
+    return task;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(free_mutex_);
+    if (!free_tasks_.empty())
+    {
+      Task_* task = free_tasks_.back();
+      free_tasks_.pop_back();
+      // refill the cache while holding the lock, so the next submits take none
+      if (slot != NO_SLOT_)
+      {
+        unsigned count = std::min(unsigned(free_tasks_.size()), unsigned(TASK_BATCH_));
+        slots_[slot].free_tasks.insert(slots_[slot].free_tasks.end(), free_tasks_.end() - count, free_tasks_.end());
+        free_tasks_.resize(free_tasks_.size() - count);
+      }
+      return task;
+    }
+  }
+  return new Task_{nullptr, nullptr};
+}
+
+void ThreadPool::ReleaseTask_(Task_* task, unsigned slot)
+{
+  // drops the captures now rather than when the task is next reused
+  task->function = nullptr;
+
+  if (slot == NO_SLOT_)
+  {
+    std::lock_guard<std::mutex> lock(free_mutex_);
+    free_tasks_.push_back(task);
+    return;
+  }
+
+  // threads that mostly run tasks pass them on to threads that mostly submit them
+  std::vector<Task_*>& cache = slots_[slot].free_tasks;
+  cache.push_back(task);
+  if (cache.size() < TASK_BATCH_ * 2)
+    return;
+  std::lock_guard<std::mutex> lock(free_mutex_);
+  free_tasks_.insert(free_tasks_.end(), cache.end() - TASK_BATCH_, cache.end());
+  cache.resize(cache.size() - TASK_BATCH_);
+}
@@ -0,0 +1,190 @@
+/*! \file ThreadPool.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains ThreadPool, a fixed set of worker threads that steal tasks from each other.
+*/
+
+#pragma once
+
+#include "WorkStealingDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! Counts unfinished tasks so a caller can wait for a group of them.
+struct TaskCounter
+{
+  TaskCounter() : pending(0) {}
+  std::atomic<unsigned> pending;
+};
+
+/*! Worker threads each with their own deque of tasks.
+
+    A task submitted from a worker goes on that worker's deque, and one
+    submitted from the thread that created the pool goes on a deque of its
+    own, so neither takes a lock. Threads pop their own newest task first
+    and, when out of work, steal the oldest task of another thread. Tasks
+    from any other thread go through a locked queue.
+
+    Wait runs tasks while it waits, its own first, so tasks may wait on
+    tasks they submit.
+*/
+class ThreadPool
+{
+  public:
+    //! Tasks each deque holds, more spill to the locked queue.
+    static const unsigned DEQUE_CAPACITY = 4096;
+
+    //! Work done by one thread since the last TakeStats.
+    struct WorkerStats
+    {
+      //! Fraction of the time spent running tasks.
+      float utilization = 0.0f;
+      unsigned tasks = 0;
+      //! Tasks taken from another thread's deque.
+      unsigned steals = 0;
+    };
+
+    /*! \brief Starts the worker threads.
+        \param thread_count The number of workers, 0 uses one less than the hardware thread count,
+                            as the creating thread helps from Wait.
+    */
+    ThreadPool(unsigned thread_count = 0);
+
+    //! \brief Finishes queued tasks and joins the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /*! \brief Queues a task to run on a worker.
+        \param task The task to run.
+        \param counter Incremented now and decremented when the task finishes, may be nullptr.
+    */
+    void Submit(std::function<void()> task, TaskCounter* counter = nullptr);
+
+    /*! \brief Runs queued tasks on the calling thread until the counter reaches zero.
+
+        Helping instead of sleeping means tasks may wait on tasks they submit
+        without starving the pool.
+        \param counter The counter to wait on.
+    */
+    void Wait(TaskCounter& counter);
+
+    /*! \brief Runs one queued task on the calling thread, for callers waiting on something other than a TaskCounter.
+        \return False if no task was found.
+    */
+    bool RunOne();
+
+    /*! \brief Splits a range into pieces run across the pool, returning when all are done.
+        \param begin The first index.
+        \param end One past the last index.
+        \param grain The most indices per piece, pieces should take a few microseconds at least.
+        \param function Called as function(piece_begin, piece_end) for each piece, from any thread.
+    */
+    template <typename Function>
+    void ParallelFor(unsigned begin, unsigned end, unsigned grain, const Function& function);
+
+    //! \return The number of worker threads.
+    unsigned ThreadCount() const { return unsigned(workers_.size()); }
+
+    /*! \brief Reports the work of every thread since the last call, then starts counting again.
+        \param stats Receives the creating thread first, then each worker.
+    */
+    void TakeStats(std::vector<WorkerStats>& stats);
+
+  private:
+    //! Slot of threads that are neither workers nor the creating thread.
+    static const unsigned NO_SLOT_ = ~0u;
+    //! Tasks moved at once between a thread's cache and the shared free list.
+    static const unsigned TASK_BATCH_ = 64;
+
+    struct Task_
+    {
+      std::function<void()> function;
+      TaskCounter* counter;
+    };
+
+    //! A deque and counters for one thread, on its own cache lines.
+    struct alignas(64) Slot_
+    {
+      Slot_() : tasks(DEQUE_CAPACITY), busy_ns(0), task_count(0), steals(0) { free_tasks.reserve(TASK_BATCH_ * 2); }
+
+      WorkStealingDeque<Task_> tasks;
+      //! Finished tasks, used only by the slot's own thread.
+      std::vector<Task_*> free_tasks;
+      std::atomic<unsigned long long> busy_ns;
+      std::atomic<unsigned> task_count;
+      std::atomic<unsigned> steals;
+    };
+
+    //! \brief Loop run by each worker thread.
+    void WorkerLoop_(unsigned slot);
+
+    //! \return The slot of the calling thread, NO_SLOT_ if it has none.
+    unsigned CurrentSlot_() const;
+
+    //! \return A task from the slot's deque, the locked queue, or another deque, nullptr if none were found.
+    Task_* Take_(unsigned slot);
+
+    //! \brief Runs and releases a task, counting its time against the slot.
+    void Run_(Task_* task, unsigned slot);
+
+    //! \return A finished task to reuse from the slot's cache or the shared free list, or a new one.
+    Task_* AllocateTask_(unsigned slot);
+
+    //! \brief Returns a finished task to the slot's cache, handing a batch on when the cache is full.
+    void ReleaseTask_(Task_* task, unsigned slot);
+
+    std::vector<std::thread> workers_;
+    //! Slot 0 is the creating thread, then one per worker.
+    std::unique_ptr<Slot_[]> slots_;
+    unsigned slot_count_;
+    std::thread::id owner_;
+
+    //! Tasks from threads without a slot, or from full deques.
+    std::deque<Task_*> shared_;
+    std::mutex shared_mutex_;
+    //! Size of shared_, read without the lock to skip it when empty.
+    std::atomic<unsigned> shared_count_;
+
+    //! Finished tasks not held by any slot.
+    std::vector<Task_*> free_tasks_;
+    std::mutex free_mutex_;
+
+    //! Tasks submitted and not yet taken, workers sleep while it is zero.
+    std::atomic<unsigned> queued_;
+    std::atomic<unsigned> sleeping_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> stopping_;
+
+    std::chrono::steady_clock::time_point stats_start_;
+};
+
+template <typename Function>
+void ThreadPool::ParallelFor(unsigned begin, unsigned end, unsigned grain, const Function& function)
+{
+  if (begin >= end)
+    return;
+  grain = std::max(grain, 1u);
+
+  // the calling thread keeps the first piece, the rest wait in its deque to be stolen
+  TaskCounter counter;
+  unsigned first_end = end - begin > grain ? begin + grain : end;
+  for (unsigned piece = first_end; piece < end; piece += std::min(grain, end - piece))
+  {
+    unsigned piece_end = piece + std::min(grain, end - piece);
+    Submit([&function, piece, piece_end]() { function(piece, piece_end); }, &counter);
+  }
+  function(begin, first_end);
+  Wait(counter);
+}
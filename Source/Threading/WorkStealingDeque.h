@@ -0,0 +1,108 @@
+/*! \file WorkStealingDeque.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains WorkStealingDeque class template, a fixed capacity Chase-Lev deque of pointers.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/*! A deque one thread pushes and pops at the bottom while any thread
+    steals from the top, without locks.
+
+    The owner works newest first, which keeps the data of work it just
+    split off warm in its cache, while thieves take the oldest, usually
+    the largest, pieces. Only the last item is contended, settled by a
+    compare exchange on top.
+
+    Follows Le, Pop, Cohen, and Zappa Nardelli, "Correct and Efficient
+    Work-Stealing for Weak Memory Models", with a fixed capacity instead of
+    growing, so Push fails rather than allocating when full.
+*/
+template <typename T>
+class WorkStealingDeque
+{
+  public:
+    //! \param capacity The most items held at once, rounded up to a power of two.
+    explicit WorkStealingDeque(unsigned capacity) : top_(0), bottom_(0)
+    {
+      unsigned size = 1;
+      while (size < capacity)
+        size <<= 1;
+      mask_ = size - 1;
+      items_.reset(new std::atomic<T*>[size]);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /*! \brief Adds an item at the bottom, owner thread only.
+        \return False if the deque is full.
+    */
+    bool Push(T* item)
+    {
+      int64_t bottom = bottom_.load(std::memory_order_relaxed);
+      int64_t top = top_.load(std::memory_order_acquire);
+      if (bottom - top > int64_t(mask_))
+        return false;
+      items_[bottom & mask_].store(item, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return true;
+    }
+
+    //! \return The newest item, or nullptr if empty or a thief took the last one. Owner thread only.
+    T* Pop()
+    {
+      int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+      bottom_.store(bottom, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t top = top_.load(std::memory_order_relaxed);
+      if (top > bottom)
+      {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+      }
+
+      T* item = items_[bottom & mask_].load(std::memory_order_relaxed);
+      if (top == bottom)
+      {
+        // the last item, race thieves for it
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          item = nullptr;
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+      }
+      return item;
+    }
+
+    //! \return The oldest item, or nullptr if empty or another thread got it first. Any thread.
+    T* Steal()
+    {
+      int64_t top = top_.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t bottom = bottom_.load(std::memory_order_acquire);
+      if (top >= bottom)
+        return nullptr;
+
+      T* item = items_[top & mask_].load(std::memory_order_relaxed);
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+      return item;
+    }
+
+    //! \return True if the deque looked empty, only a hint while other threads use it.
+    bool Empty() const
+    {
+      return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    //! Kept on separate cache lines, thieves write top while the owner writes bottom.
+    alignas(64) std::atomic<int64_t> top_;
+    alignas(64) std::atomic<int64_t> bottom_;
+    std::unique_ptr<std::atomic<T*>[]> items_;
+    int64_t mask_;
+};
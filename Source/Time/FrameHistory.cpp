@@ -0,0 +1,168 @@
+/*! \file FrameHistory.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of FrameHistory class.
+*/
+
+#include "FrameHistory.h"
+
+#include <algorithm>
+#include <cmath>
+
+// HELPER FUNCTIONS START
+
+/*! \brief Returns the nearest rank percentile of sorted values.
+    \param sorted The values in ascending order, not empty.
+    \param count The number of values.
+    \param percentile From 0 to 1.
+*/
+static float NearestRank(const float* sorted, size_t count, double percentile)
+{
+  size_t rank = size_t(std::ceil(percentile * double(count)));
+  return sorted[rank ? rank - 1 : 0];
+}
+
+//! Writes a string as a JSON string, names are plain but quotes and backslashes are escaped anyway.
+static void WriteJsonString(std::ostream& out, const std::string& text)
+{
+  out << '"';
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\')
+      out << '\\';
+    out << c;
+  }
+  out << '"';
+}
+
+// HELPER FUNCTIONS END
+
+FrameHistory::FrameHistory() : slots_(new Slot_[CAPACITY]), written_(0)
+{
+}
+
+unsigned FrameHistory::AddColumn(const char* name)
+{
+  if (names_.size() >= MAX_COLUMNS)
+    return MAX_COLUMNS;
+  names_.push_back(name);
+  return unsigned(names_.size() - 1);
+}
+
+void FrameHistory::Record(const float* values)
+{
+  unsigned long long frame = written_.load(std::memory_order_relaxed);
+  Slot_& slot = slots_[frame % CAPACITY];
+
+  // odd tells readers the slot is changing, the fence keeps the writes below after it
+  unsigned sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.frame.store(frame, std::memory_order_relaxed);
+  for (size_t column = 0; column < names_.size(); ++column)
+    slot.values[column].store(values[column], std::memory_order_relaxed);
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+
+  written_.store(frame + 1, std::memory_order_release);
+}
+
+void FrameHistory::Read(Rows& rows) const
+{
+  unsigned long long written = written_.load(std::memory_order_acquire);
+  unsigned long long first = written > CAPACITY ? written - CAPACITY : 0;
+  size_t columns = names_.size();
+  rows.frames.clear();
+  rows.values.resize(size_t(written - first) * columns);
+
+  float* values = rows.values.data();
+  for (unsigned long long frame = first; frame < written; ++frame)
+  {
+    const Slot_& slot = slots_[frame % CAPACITY];
+    unsigned before = slot.sequence.load(std::memory_order_acquire);
+    unsigned long long slot_frame = slot.frame.load(std::memory_order_relaxed);
+    for (size_t column = 0; column < columns; ++column)
+      values[column] = slot.values[column].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    unsigned after = slot.sequence.load(std::memory_order_relaxed);
+
+    // torn by the writer or already holding a newer frame, the ones after it are newer still
+    if ((before & 1) || before != after || slot_frame != frame)
+      continue;
+    rows.frames.push_back(frame);
+    values += columns;
+  }
+  rows.values.resize(rows.frames.size() * columns);
+}
+
+FrameHistory::Percentiles FrameHistory::Summarize(const Rows& rows, unsigned column, std::vector<float>& scratch) const
+{
+  Percentiles result;
+  if (!rows.Count())
+    return result;
+
+  size_t columns = names_.size();
+  scratch.resize(rows.Count());
+  for (unsigned row = 0; row < rows.Count(); ++row)
+    scratch[row] = rows.values[row * columns + column];
+  std::sort(scratch.begin(), scratch.end());
+
+  result.p50 = NearestRank(scratch.data(), scratch.size(), 0.50);
+  result.p95 = NearestRank(scratch.data(), scratch.size(), 0.95);
+  result.p99 = NearestRank(scratch.data(), scratch.size(), 0.99);
+  result.max = scratch.back();
+  return result;
+}
+
+void FrameHistory::WriteCsv(std::ostream& out) const
+{
+  Rows rows;
+  Read(rows);
+
+  out << "frame";
+  for (const std::string& name : names_)
+    out << ',' << name;
+  out << '\n';
+
+  size_t columns = names_.size();
+  for (unsigned row = 0; row < rows.Count(); ++row)
+  {
+    out << rows.frames[row];
+    for (size_t column = 0; column < columns; ++column)
+      out << ',' << rows.values[row * columns + column];
+    out << '\n';
+  }
+}
+
+void FrameHistory::WriteJson(std::ostream& out) const
+{
+  Rows rows;
+  Read(rows);
+  std::vector<float> scratch;
+  size_t columns = names_.size();
+
+  out << "{\n  \"columns\": [";
+  for (size_t column = 0; column < columns; ++column)
+  {
+    out << (column ? ", " : "");
+    WriteJsonString(out, names_[column]);
+  }
+
+  out << "],\n  \"percentiles\": {";
+  for (unsigned column = 0; column < columns; ++column)
+  {
+    Percentiles summary = Summarize(rows, column, scratch);
+    out << (column ? ",\n    " : "\n    ");
+    WriteJsonString(out, names_[column]);
+    out << ": {\"p50\": " << summary.p50 << ", \"p95\": " << summary.p95 << ", \"p99\": " << summary.p99 << ", \"max\": " << summary.max << '}';
+  }
+
+  out << "\n  },\n  \"frames\": [";
+  for (unsigned row = 0; row < rows.Count(); ++row)
+  {
+    out << (row ? ",\n    " : "\n    ") << "{\"frame\": " << rows.frames[row] << ", \"ms\": [";
+    for (size_t column = 0; column < columns; ++column)
+      out << (column ? ", " : "") << rows.values[row * columns + column];
+    out << "]}";
+  }
+  out << "\n  ]\n}\n";
+}
@@ -0,0 +1,114 @@
+/*! \file FrameHistory.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains FrameHistory class, a lock-free ring of recent frame timings with percentiles and export.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*! The timings of the last CAPACITY frames, one row of named columns per
+    frame, such as the whole frame and each stage of it.
+
+    One thread records while any thread may read. Each slot carries a
+    sequence number that is odd while the slot is being written, so a
+    reader copies a slot and keeps it only if the number was even and
+    unchanged around the copy. Neither side ever waits on the other. The
+    slot's contents are relaxed atomics, so a copy torn by the writer is
+    discarded rather than being a data race.
+
+    Percentiles show the hitches an average hides: a p99 far above the p50
+    means one frame in a hundred stalls.
+*/
+class FrameHistory
+{
+  public:
+    //! Frames kept.
+    static const unsigned CAPACITY = 512;
+    //! Most columns per frame.
+    static const unsigned MAX_COLUMNS = 32;
+
+    //! Summary of one column over the frames read.
+    struct Percentiles
+    {
+      float p50 = 0.0f;
+      float p95 = 0.0f;
+      float p99 = 0.0f;
+      float max = 0.0f;
+    };
+
+    //! Frames copied out by Read, oldest first.
+    struct Rows
+    {
+      //! Frame numbers, from 0.
+      std::vector<unsigned long long> frames;
+      //! ColumnCount values per frame, frame after frame.
+      std::vector<float> values;
+
+      //! \return The number of frames.
+      unsigned Count() const { return unsigned(frames.size()); }
+    };
+
+    FrameHistory();
+
+    /*! \brief Adds a column, call before the first Record.
+        \param name Shown and exported, copied.
+        \return The index of the column, or MAX_COLUMNS if there are too many.
+    */
+    unsigned AddColumn(const char* name);
+
+    //! \return The number of columns.
+    unsigned ColumnCount() const { return unsigned(names_.size()); }
+    //! \return The name of a column.
+    const char* ColumnName(unsigned column) const { return names_[column].c_str(); }
+
+    /*! \brief Records a frame, overwriting the oldest once full. Only one thread may record.
+        \param values ColumnCount values, in milliseconds.
+    */
+    void Record(const float* values);
+
+    /*! \brief Copies the recorded frames, any thread.
+        \param rows Receives the frames, its storage is reused.
+    */
+    void Read(Rows& rows) const;
+
+    /*! \brief Computes nearest rank percentiles of one column.
+        \param rows Frames from Read.
+        \param column The column.
+        \param scratch Sorted in place of the column, its storage is reused.
+        \return The percentiles, zero if there are no frames.
+    */
+    Percentiles Summarize(const Rows& rows, unsigned column, std::vector<float>& scratch) const;
+
+    //! \brief Writes the recorded frames as CSV, a header row then a row per frame.
+    void WriteCsv(std::ostream& out) const;
+
+    //! \brief Writes the recorded frames and the percentiles of each column as JSON.
+    void WriteJson(std::ostream& out) const;
+
+  private:
+    //! One frame, on its own cache lines so readers of one slot do not slow the writer of the next.
+    struct alignas(64) Slot_
+    {
+      Slot_() : sequence(0), frame(0)
+      {
+        for (std::atomic<float>& value : values)
+          value.store(0.0f, std::memory_order_relaxed);
+      }
+
+      //! Odd while being written.
+      std::atomic<unsigned> sequence;
+      std::atomic<unsigned long long> frame;
+      std::atomic<float> values[MAX_COLUMNS];
+    };
+
+    std::vector<std::string> names_;
+    std::unique_ptr<Slot_[]> slots_;
+    //! Frames recorded since construction.
+    std::atomic<unsigned long long> written_;
+};
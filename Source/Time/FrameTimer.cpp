@@ -0,0 +1,51 @@
+/*! \file FrameTimer.cpp
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Implementation of FrameTimer class.
+*/
+
+#include "FrameTimer.h"
+
+FrameTimer::FrameTimer(double step, double spike_limit) : step_ns_((long long)(step * 1e9)), spike_limit_ns_((long long)(spike_limit * 1e9)), accumulator_ns_(0), frame_ns_(0), steps_(0), spikes_(0), frames_(0)
+{
+  if (step_ns_ < 1)
+    step_ns_ = 1;
+  Start();
+}
+
+void FrameTimer::Start()
+{
+  last_ = std::chrono::steady_clock::now();
+  accumulator_ns_ = 0;
+  frame_ns_ = 0;
+  steps_ = 0;
+  spikes_ = 0;
+  frames_ = 0;
+}
+
+void FrameTimer::Tick()
+{
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  long long elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count();
+  last_ = now;
+  frame_ns_ = (unsigned long long)elapsed;
+  ++frames_;
+  steps_ = 0;
+
+  // a stall would otherwise be simulated in one burst of steps, each making the next frame longer
+  if (elapsed > spike_limit_ns_)
+  {
+    elapsed = spike_limit_ns_;
+    ++spikes_;
+  }
+  accumulator_ns_ += elapsed;
+}
+
+bool FrameTimer::Step()
+{
+  if (accumulator_ns_ < step_ns_)
+    return false;
+  accumulator_ns_ -= step_ns_;
+  ++steps_;
+  return true;
+}
@@ -0,0 +1,72 @@
+/*! \file FrameTimer.h
+    \date 10/16/2026
+    \author Raymond Moorhead
+    \brief Contains FrameTimer class, which measures frames on the steady clock and hands out fixed simulation steps.
+*/
+
+#pragma once
+
+#include <chrono>
+
+/*! Measures each frame in nanoseconds on std::chrono::steady_clock, which
+    never jumps with wall clock adjustments, and feeds the time into an
+    accumulator drained in fixed steps.
+
+    The simulation advances only by whole steps, so it behaves the same at
+    any frame rate. What is left in the accumulator is less than one step,
+    and Alpha is that fraction, used to interpolate between the last two
+    simulated states when drawing. A frame longer than the spike limit,
+    such as a stall or a breakpoint, is clamped so the simulation does not
+    try to catch up on all of it at once.
+*/
+class FrameTimer
+{
+  public:
+    //! Seconds per simulation step.
+    static constexpr double DEFAULT_STEP = 1.0 / 60.0;
+    //! Longest frame fed into the accumulator, in seconds.
+    static constexpr double DEFAULT_SPIKE_LIMIT = 0.25;
+
+    /*! \param step Seconds per simulation step.
+        \param spike_limit Longest frame fed into the accumulator, in seconds.
+    */
+    FrameTimer(double step = DEFAULT_STEP, double spike_limit = DEFAULT_SPIKE_LIMIT);
+
+    //! \brief Starts timing from now with an empty accumulator, call right before the first frame.
+    void Start();
+
+    //! \brief Ends the current frame, measuring it and adding it to the accumulator. Call once per frame.
+    void Tick();
+
+    /*! \brief Takes one fixed step from the accumulator if one is due, call in a loop after Tick.
+        \return True if the simulation should advance by StepSeconds.
+    */
+    bool Step();
+
+    //! \return The fraction of a step left in the accumulator, from 0 to 1, for interpolating the last two steps.
+    float Alpha() const { return float(double(accumulator_ns_) / double(step_ns_)); }
+
+    //! \return Seconds per simulation step.
+    double StepSeconds() const { return double(step_ns_) * 1e-9; }
+    //! \return The measured length of the last frame, not clamped.
+    unsigned long long FrameNs() const { return frame_ns_; }
+    //! \return The measured length of the last frame in seconds, not clamped.
+    double FrameSeconds() const { return double(frame_ns_) * 1e-9; }
+    //! \return Steps taken since the last Tick.
+    unsigned StepsThisFrame() const { return steps_; }
+    //! \return Frames clamped since Start.
+    unsigned Spikes() const { return spikes_; }
+    //! \return Frames since Start.
+    unsigned long long Frames() const { return frames_; }
+
+  private:
+    std::chrono::steady_clock::time_point last_;
+    long long step_ns_;
+    long long spike_limit_ns_;
+    //! Integer nanoseconds, so steps never drift from the clock.
+    long long accumulator_ns_;
+    unsigned long long frame_ns_;
+    unsigned steps_;
+    unsigned spikes_;
+    unsigned long long frames_;
+};
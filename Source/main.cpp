@@ -1,22 +1,20 @@
 #include "Graphics/Graphics.h"
-#include <chrono>
-
-#define TIME_NOW std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count()
+#include "Time/FrameTimer.h"
 
 int main(int argc, char* argv[])
 {
-  float delta_time;
-  long long cur_time = TIME_NOW, old_time_;
+  FrameTimer timer;
 
   GRAPHICS.Initialize();
 
+  // timed from here so the first frame does not include startup
+  timer.Start();
   do
   {
-    // calculate delta time
-    old_time_ = cur_time;
-    cur_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-    delta_time = float(double(cur_time - old_time_) / 1000.0);
-  } while (GRAPHICS.Update(delta_time));
+    timer.Tick();
+  } while (GRAPHICS.Update(timer));
+
+  GRAPHICS.Exit();
 
   return 0;
-}
\ No newline at end of file
+}
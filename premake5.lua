@@ -1,6 +1,7 @@
 workspace("3D_GraphicsTest")
 configurations {"Debug", "Release"}
 platforms {"x64"}
+cppdialect "C++17"
 
 local project_action = "UNDEFINED"
 if _ACTION ~= nill then
@@ -62,4 +63,33 @@ project "3D_GraphicsTest"
   }
 	
 	
-	
\ No newline at end of file
+	
+project "3D_GraphicsTest_Benchmarks"
+  kind "ConsoleApp"
+  language "C++"
+  
+  targetdir "%{cfg.buildcfg}_%{cfg.platform}"
+  targetname "3D_GraphicsTest_Benchmarks"
+
+  -- only the engine code that runs without a window belongs here
+  files
+  {
+    "./Benchmarks/**.cpp", "./Benchmarks/**.h",
+    "./Source/Math/**.cpp", "./Source/Math/**.h",
+    "./Source/Memory/**.h", "./Source/Memory/MappedFile.cpp",
+    "./Source/Threading/**.h", "./Source/Threading/**.cpp",
+    "./Source/Graphics/Model/MeshData.*", "./Source/Graphics/Model/ObjParser.*",
+    "./Source/Graphics/Model/MeshCache.*", "./Source/Graphics/Model/MeshOptimizer.*",
+    "./Source/Graphics/Model/MeshSimplifier.*"
+  }
+
+  vpaths 
+  {
+    ["Header Files/*"] = { "./Benchmarks/**.h", "./Source/**.h"},
+    ["Source Files/*"] = {"./Benchmarks/**.cpp", "./Source/**.cpp"},
+  }
+
+  includedirs 
+  {
+    "./Dependencies"
+  }